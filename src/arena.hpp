@@ -0,0 +1,118 @@
+/**
+ * @file    G-Programming-Language/Compiler/arena.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_ARENA_HPP
+#define G_ARENA_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Bump allocator: memory is handed out from big blocks
+ * and released all together when the arena is destroyed.
+ * It must be used by one thread at a time.
+ */
+class Arena
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param blockSize size of every block in bytes
+     */
+    explicit Arena(size_t blockSize = 64 * 1024) : blockSize(blockSize), used(0), capacity(0) {}
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * Allocates memory from the current block
+     *
+     * @param size      number of bytes
+     * @param alignment of the memory returned
+     * @return pointer to the memory
+     */
+    void *allocate(size_t size, size_t alignment)
+    {
+        size_t offset = (used + alignment - 1) & ~(alignment - 1);
+        if (blocks.empty() || offset + size > capacity)
+        {
+            capacity = std::max(blockSize, size + alignment);
+            blocks.emplace_back(new char[capacity]);
+            offset = 0;
+        }
+        char *block = blocks.back().get();
+        // blocks come from new[], so only the offset has to be aligned
+        used = offset + size;
+        return block + offset;
+    }
+
+private:
+    /**
+     * Size of a new block
+     */
+    size_t blockSize;
+
+    /**
+     * Bytes used in the current block
+     */
+    size_t used;
+
+    /**
+     * Size of the current block
+     */
+    size_t capacity;
+
+    /**
+     * All the blocks allocated
+     */
+    std::vector<std::unique_ptr<char[]>> blocks;
+};
+
+/**
+ * Standard allocator taking memory from an Arena. Every copy
+ * shares the arena, so it lives as long as what it allocated.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(const std::shared_ptr<Arena> &arena) : arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+
+    T *allocate(size_t n)
+    {
+        return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const
+    {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const
+    {
+        return arena != other.arena;
+    }
+
+    std::shared_ptr<Arena> arena;
+};
+
+#endif // G_ARENA_HPP
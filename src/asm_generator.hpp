@@ -0,0 +1,898 @@
+/**
+ * @file    G-Programming-Language/Compiler/asm_generator.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_ASM_GENERATOR_HPP
+#define G_ASM_GENERATOR_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "./ir.hpp"
+
+/**
+ * x86-64 backend: translates a program in SSA form to GNU as
+ * assembly for Linux, in AT&T syntax.
+ *
+ * Values get registers by linear scan: blocks are laid out in
+ * reverse postorder, which is a topological order since programs
+ * have no loops, so a value is live from its definition to its
+ * last use in that order. When registers run out, the value
+ * live the longest goes to a stack slot for its whole life.
+ * bool, char and int are 32 bit registers (chars sign extended),
+ * float and double SSE registers, strings pointers to constants.
+ * rax, rdx, r11, xmm14 and xmm15 are never allocated, they are
+ * the scratch registers of the instructions.
+ *
+ * The final value of every variable 'x' is stored in the global
+ * 'G_x' (8 bytes), the program is the function 'g_main'.
+ */
+class AsmGenerator
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param program to translate, verified
+     */
+    explicit AsmGenerator(const IrProgram &program) : program(program) {}
+
+    /**
+     * Names what the backend cannot translate
+     *
+     * @return empty if the whole program can be translated
+     */
+    std::string unsupported() const
+    {
+        for (const Instruction &instruction : program.getInstructions())
+        {
+            bool isString = instruction.type == IrType::STRING;
+            if (isBinary(instruction.op) || instruction.op == Opcode::CONVERT)
+            {
+                isString = isString || program.at(instruction.args[0]).type == IrType::STRING;
+            }
+            if (isString && instruction.op != Opcode::CONST && instruction.op != Opcode::UNDEF)
+            {
+                return "operations on strings (line " + std::to_string(instruction.line) + ")";
+            }
+            if (instruction.op == Opcode::CONST && !isFloating(instruction.type) &&
+                instruction.type != IrType::STRING && instruction.constant.integer != (int32_t)instruction.constant.integer)
+            {
+                // C++ makes them long long, and so the whole expression
+                return "integers wider than an int (line " + std::to_string(instruction.line) + ")";
+            }
+            if (instruction.op == Opcode::PHI && isFloating(instruction.type))
+            {
+                return "floating point phis (line " + std::to_string(instruction.line) + ")";
+            }
+        }
+        return "";
+    }
+
+    /**
+     * Translates the program
+     *
+     * @param entry also define '_start', which runs the program and
+     *              exits, for an executable linked without libc
+     * @return the assembly
+     */
+    std::string generate(bool entry = true)
+    {
+        layOut();
+        allocate();
+
+        code.clear();
+        code += "\t.text\n\t.globl\tg_main\n\t.type\tg_main, @function\ng_main:\n";
+        for (int r = 0; r < 5; ++r)
+        {
+            line("pushq", saved(r));
+        }
+        if (frame)
+        {
+            line("subq", "$" + std::to_string(frame), "%rsp");
+        }
+
+        const std::vector<Instruction> &instructions = program.getInstructions();
+        for (size_t i = 0; i < layout.size(); ++i)
+        {
+            uint32_t b = layout[i];
+            next = i + 1 < layout.size() ? layout[i + 1] : IrProgram::NO_VALUE;
+            code += blockLabel(b);
+            code += ":\n";
+            for (uint32_t id : program.getBlocks()[b].code)
+            {
+                translate(b, id, instructions[id]);
+                storeVariables(id);
+            }
+        }
+        code += "\t.size\tg_main, .-g_main\n";
+
+        if (entry)
+        {
+            code += "\t.globl\t_start\n_start:\n";
+            line("call", "g_main");
+            line("movl", "$60", "%eax");
+            line("xorl", "%edi", "%edi");
+            line("syscall");
+        }
+        data();
+        code += "\t.section\t.note.GNU-stack,\"\",@progbits\n";
+        return code;
+    }
+
+    /**
+     * Number of values that live on the stack
+     */
+    size_t getSpilled() const
+    {
+        return spilled;
+    }
+
+    /**
+     * Bytes of stack used by the values
+     */
+    size_t getFrameSize() const
+    {
+        return frame;
+    }
+
+private:
+    /**
+     * Allocatable registers, 64 and 32 bit names
+     */
+    static constexpr int GPRS = 11;
+    static constexpr int XMMS = 14;
+
+    static const char *gpr64(int r)
+    {
+        static const char *const names[GPRS] = {"%rbx", "%rcx", "%rsi", "%rdi", "%r8", "%r9", "%r10", "%r12", "%r13", "%r14", "%r15"};
+        return names[r];
+    }
+
+    static const char *gpr32(int r)
+    {
+        static const char *const names[GPRS] = {"%ebx", "%ecx", "%esi", "%edi", "%r8d", "%r9d", "%r10d", "%r12d", "%r13d", "%r14d", "%r15d"};
+        return names[r];
+    }
+
+    /**
+     * Callee saved registers pushed by the prologue, in order
+     */
+    static const char *saved(int r)
+    {
+        static const char *const names[5] = {"%rbx", "%r12", "%r13", "%r14", "%r15"};
+        return names[r];
+    }
+
+    /**
+     * Location of a value with no location
+     */
+    static const int32_t NOWHERE = INT32_MIN;
+
+    const IrProgram &program;
+
+    /**
+     * Reachable blocks in reverse postorder, and the block after
+     * the one being translated
+     */
+    std::vector<uint32_t> layout;
+    uint32_t next = 0;
+
+    /**
+     * Live interval of every value, in positions of the layout
+     */
+    std::vector<uint32_t> start;
+    std::vector<uint32_t> end;
+
+    /**
+     * Register of every value if >= 0, stack slot -location-1
+     * otherwise
+     */
+    std::vector<int32_t> location;
+
+    size_t spilled = 0;
+
+    size_t frame = 0;
+
+    /**
+     * Offset of the stack area phis are copied through
+     */
+    size_t parallel = 0;
+
+    /**
+     * Variables whose final value each value is, as a list:
+     * first variable by value, next variable by variable
+     */
+    std::vector<uint32_t> firstVariable;
+    std::vector<uint32_t> nextVariable;
+
+    /**
+     * Floating point constants: bits and size, and their label
+     */
+    std::map<std::pair<uint64_t, int>, size_t> constants;
+
+    /**
+     * Strings used, by interner id
+     */
+    std::set<uint32_t> strings;
+
+    std::string code;
+
+    static bool isFloating(IrType type)
+    {
+        return type == IrType::FLOAT || type == IrType::DOUBLE;
+    }
+
+    static std::string blockLabel(uint32_t b)
+    {
+        return ".Lb" + std::to_string(b);
+    }
+
+    void line(const std::string &mnemonic, const std::string &a = "", const std::string &b = "")
+    {
+        code += '\t';
+        code += mnemonic;
+        if (!a.empty())
+        {
+            code += '\t';
+            code += a;
+        }
+        if (!b.empty())
+        {
+            code += ", ";
+            code += b;
+        }
+        code += '\n';
+    }
+
+    void layOut()
+    {
+        const std::vector<BasicBlock> &blocks = program.getBlocks();
+        std::vector<char> visited(blocks.size(), 0);
+        std::vector<std::pair<uint32_t, size_t>> stack = {{0, 0}};
+        visited[0] = 1;
+        // postorder, without recursion: conditionals nest deeply
+        while (!stack.empty())
+        {
+            uint32_t b = stack.back().first;
+            std::vector<uint32_t> successors = program.successors(b);
+            if (stack.back().second < successors.size())
+            {
+                uint32_t s = successors[stack.back().second++];
+                if (!visited[s])
+                {
+                    visited[s] = 1;
+                    stack.push_back({s, 0});
+                }
+                continue;
+            }
+            layout.push_back(b);
+            stack.pop_back();
+        }
+        std::reverse(layout.begin(), layout.end());
+    }
+
+    /**
+     * Linear scan register allocation
+     */
+    void allocate()
+    {
+        const std::vector<Instruction> &instructions = program.getInstructions();
+        const std::vector<BasicBlock> &blocks = program.getBlocks();
+        start.assign(instructions.size(), 0);
+        end.assign(instructions.size(), 0);
+        location.assign(instructions.size(), int32_t(NOWHERE));
+        std::vector<uint32_t> blockEnd(blocks.size(), 0);
+
+        uint32_t position = 0;
+        for (uint32_t b : layout)
+        {
+            for (uint32_t id : blocks[b].code)
+            {
+                start[id] = end[id] = position++;
+            }
+            blockEnd[b] = position - 1;
+        }
+        size_t phis = 0;
+        for (uint32_t b : layout)
+        {
+            size_t blockPhis = 0;
+            for (uint32_t id : blocks[b].code)
+            {
+                const Instruction &instruction = instructions[id];
+                unsigned count = instruction.op == Opcode::NEG || instruction.op == Opcode::NOT ||
+                                         instruction.op == Opcode::CONVERT || instruction.op == Opcode::CBR
+                                     ? 1
+                                 : isBinary(instruction.op) ? 2
+                                                            : 0;
+                for (unsigned a = 0; a < count; ++a)
+                {
+                    uint32_t &last = end[instruction.args[a]];
+                    last = std::max(last, start[id]);
+                }
+                if (instruction.op == Opcode::PHI)
+                {
+                    // written and read by the moves at the end of the
+                    // predecessors, which come before in the layout
+                    const PhiInput *inputs = program.inputsOf(instruction);
+                    for (uint32_t p = 0; p < instruction.args[1]; ++p)
+                    {
+                        uint32_t &last = end[inputs[p].value];
+                        last = std::max(last, blockEnd[inputs[p].block]);
+                        start[id] = std::min(start[id], blockEnd[inputs[p].block]);
+                    }
+                    ++blockPhis;
+                }
+            }
+            phis = std::max(phis, blockPhis);
+        }
+
+        std::vector<uint32_t> order;
+        for (uint32_t b : layout)
+        {
+            for (uint32_t id : blocks[b].code)
+            {
+                if (instructions[id].type != IrType::VOID)
+                {
+                    order.push_back(id);
+                }
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+                         { return start[a] < start[b]; });
+
+        // active values by end, of each register class, and free
+        // stack slots by the end of their last value
+        std::set<std::pair<uint32_t, uint32_t>> active[2];
+        std::set<std::pair<uint32_t, uint32_t>> activeSlots;
+        std::set<std::pair<uint32_t, int32_t>> freeSlots;
+        std::vector<int32_t> free[2];
+        for (int r = GPRS; r-- > 0;)
+        {
+            free[0].push_back(r);
+        }
+        for (int r = XMMS; r-- > 0;)
+        {
+            free[1].push_back(r);
+        }
+        int32_t slots = 0;
+        auto spill = [&](uint32_t id)
+        {
+            // a value that gives up its register is on the stack
+            // since its definition: the slot must be free since then
+            int32_t slot = slots;
+            if (!freeSlots.empty() && freeSlots.begin()->first < start[id])
+            {
+                slot = freeSlots.begin()->second;
+                freeSlots.erase(freeSlots.begin());
+            }
+            else
+            {
+                ++slots;
+            }
+            location[id] = -slot - 1;
+            activeSlots.insert({end[id], id});
+            ++spilled;
+        };
+
+        for (uint32_t id : order)
+        {
+            for (int c = 0; c < 2; ++c)
+            {
+                while (!active[c].empty() && active[c].begin()->first < start[id])
+                {
+                    free[c].push_back(location[active[c].begin()->second]);
+                    active[c].erase(active[c].begin());
+                }
+            }
+            while (!activeSlots.empty() && activeSlots.begin()->first < start[id])
+            {
+                freeSlots.insert({activeSlots.begin()->first, -location[activeSlots.begin()->second] - 1});
+                activeSlots.erase(activeSlots.begin());
+            }
+
+            int c = isFloating(instructions[id].type) ? 1 : 0;
+            if (!free[c].empty())
+            {
+                location[id] = free[c].back();
+                free[c].pop_back();
+                active[c].insert({end[id], id});
+                continue;
+            }
+            auto last = std::prev(active[c].end());
+            if (last->first > end[id])
+            {
+                // the value that lives the longest gives up its register
+                uint32_t victim = last->second;
+                location[id] = location[victim];
+                active[c].erase(last);
+                active[c].insert({end[id], id});
+                spill(victim);
+            }
+            else
+            {
+                spill(id);
+            }
+        }
+        // the phis of a block are copied through the slots after these
+        parallel = (size_t)slots * 8;
+        frame = ((size_t)slots * 8 + (phis > 1 ? phis * 8 : 0) + 15) / 16 * 16;
+
+        const std::vector<IrVariable> &variables = program.getVariables();
+        firstVariable.assign(instructions.size(), uint32_t(IrProgram::NO_VALUE));
+        nextVariable.assign(variables.size(), uint32_t(IrProgram::NO_VALUE));
+        for (uint32_t v = 0; v < variables.size(); ++v)
+        {
+            uint32_t value = variables[v].value;
+            if (value != IrProgram::NO_VALUE && instructions[value].op != Opcode::UNDEF)
+            {
+                nextVariable[v] = firstVariable[value];
+                firstVariable[value] = v;
+            }
+        }
+    }
+
+    bool inRegister(uint32_t id) const
+    {
+        return location[id] >= 0;
+    }
+
+    /**
+     * Operand naming where a value is
+     */
+    std::string where(uint32_t id) const
+    {
+        int32_t at = location[id];
+        if (at < 0)
+        {
+            return std::to_string((-at - 1) * 8) + "(%rsp)";
+        }
+        IrType type = program.at(id).type;
+        if (isFloating(type))
+        {
+            return "%xmm" + std::to_string(at);
+        }
+        return type == IrType::STRING ? gpr64(at) : gpr32(at);
+    }
+
+    /**
+     * Moves a value between registers and memory, as wide as its type
+     */
+    void move(IrType type, const std::string &from, const std::string &to)
+    {
+        if (from == to)
+        {
+            return;
+        }
+        if (isFloating(type))
+        {
+            bool registers = from[0] == '%' && to[0] == '%';
+            line(registers ? "movaps" : type == IrType::FLOAT ? "movss"
+                                                              : "movsd",
+                 from, to);
+        }
+        else
+        {
+            line(type == IrType::STRING ? "movq" : "movl", from, to);
+        }
+    }
+
+    /**
+     * Register an instruction computes into: its own, or a scratch
+     * one when its value is on the stack
+     */
+    std::string target(uint32_t id, IrType type)
+    {
+        if (inRegister(id))
+        {
+            return where(id);
+        }
+        return isFloating(type) ? "%xmm15" : type == IrType::STRING ? "%rax"
+                                                                    : "%eax";
+    }
+
+    void store(uint32_t id, IrType type, const std::string &from)
+    {
+        move(type, from, where(id));
+    }
+
+    std::string constantLabel(uint64_t bits, int size)
+    {
+        auto it = constants.find({bits, size});
+        if (it == constants.end())
+        {
+            it = constants.insert({{bits, size}, constants.size()}).first;
+        }
+        return ".LC" + std::to_string(it->second);
+    }
+
+    void translate(uint32_t block, uint32_t id, const Instruction &instruction)
+    {
+        IrType type = instruction.type;
+        uint32_t a = instruction.args[0];
+        uint32_t b = instruction.args[1];
+        std::string s = type == IrType::FLOAT ? "ss" : "sd";
+        switch (instruction.op)
+        {
+        case Opcode::CONST:
+        {
+            if (isFloating(type))
+            {
+                uint64_t bits;
+                if (type == IrType::FLOAT)
+                {
+                    float real = (float)instruction.constant.real;
+                    uint32_t narrow;
+                    std::memcpy(&narrow, &real, sizeof(narrow));
+                    bits = narrow;
+                }
+                else
+                {
+                    std::memcpy(&bits, &instruction.constant.real, sizeof(bits));
+                }
+                std::string to = target(id, type);
+                line("mov" + s, constantLabel(bits, type == IrType::FLOAT ? 4 : 8) + "(%rip)", to);
+                store(id, type, to);
+            }
+            else if (type == IrType::STRING)
+            {
+                strings.insert(instruction.constant.string);
+                std::string to = target(id, type);
+                line("leaq", ".LS" + std::to_string(instruction.constant.string) + "(%rip)", to);
+                store(id, type, to);
+            }
+            else
+            {
+                line("movl", "$" + std::to_string((int32_t)instruction.constant.integer), where(id));
+            }
+            break;
+        }
+        case Opcode::UNDEF:
+        case Opcode::PHI:
+            // phis are written by the jumps to their block
+            break;
+        case Opcode::NEG:
+        {
+            std::string to = target(id, type);
+            if (isFloating(type))
+            {
+                // xorps needs a register and an aligned constant
+                move(type, where(a), "%xmm15");
+                line("xorps", type == IrType::FLOAT ? ".Lsign32(%rip)" : ".Lsign64(%rip)", "%xmm15");
+                store(id, type, "%xmm15");
+                break;
+            }
+            move(type, where(a), to);
+            line("negl", to);
+            store(id, type, to);
+            break;
+        }
+        case Opcode::NOT:
+        {
+            std::string to = target(id, type);
+            move(type, where(a), to);
+            line("xorl", "$1", to);
+            store(id, type, to);
+            break;
+        }
+        case Opcode::CONVERT:
+            convert(id, type, a, program.at(a).type);
+            break;
+        case Opcode::ADD:
+        case Opcode::SUB:
+        case Opcode::MUL:
+        case Opcode::AND:
+        case Opcode::OR:
+        case Opcode::XOR:
+        {
+            static const char *const integer[] = {"addl", "subl", "imull", "", "", "andl", "orl", "xorl"};
+            static const char *const floating[] = {"add", "sub", "mul"};
+            int index = (int)instruction.op - (int)Opcode::ADD;
+            std::string to = target(id, type);
+            move(type, where(a), to);
+            line(isFloating(type) ? floating[index] + s : integer[index], where(b), to);
+            store(id, type, to);
+            break;
+        }
+        case Opcode::DIV:
+        case Opcode::MOD:
+            if (isFloating(type))
+            {
+                std::string to = target(id, type);
+                move(type, where(a), to);
+                line("div" + s, where(b), to);
+                store(id, type, to);
+            }
+            else
+            {
+                line("movl", where(a), "%eax");
+                line("cltd");
+                line("idivl", where(b));
+                store(id, type, instruction.op == Opcode::DIV ? "%eax" : "%edx");
+            }
+            break;
+        case Opcode::EQ:
+        case Opcode::NE:
+        case Opcode::LT:
+        case Opcode::LE:
+        case Opcode::GT:
+        case Opcode::GE:
+            compare(id, instruction.op, a, b);
+            break;
+        case Opcode::BR:
+            jump(block, a);
+            break;
+        case Opcode::CBR:
+        {
+            line("cmpl", "$0", where(a));
+            uint32_t onTrue = b;
+            uint32_t onFalse = instruction.args[2];
+            if (!hasPhis(onTrue))
+            {
+                line("jne", blockLabel(onTrue));
+            }
+            else
+            {
+                std::string skip = ".Le" + std::to_string(id);
+                line("je", skip);
+                moves(block, onTrue);
+                line("jmp", blockLabel(onTrue));
+                code += skip + ":\n";
+            }
+            jump(block, onFalse);
+            break;
+        }
+        case Opcode::RET:
+            if (frame)
+            {
+                line("addq", "$" + std::to_string(frame), "%rsp");
+            }
+            for (int r = 5; r-- > 0;)
+            {
+                line("popq", saved(r));
+            }
+            line("ret");
+            break;
+        }
+    }
+
+    void compare(uint32_t id, Opcode op, uint32_t a, uint32_t b)
+    {
+        IrType type = program.at(a).type;
+        if (isFloating(type))
+        {
+            // ucomis sets the flags of an unsigned comparison, and all
+            // of ZF, PF and CF when a value is NaN: 'less' is 'greater'
+            // swapped, and (in)equality checks PF
+            bool swap = op == Opcode::LT || op == Opcode::LE;
+            move(type, where(swap ? b : a), "%xmm15");
+            line(type == IrType::FLOAT ? "ucomiss" : "ucomisd", where(swap ? a : b), "%xmm15");
+            switch (op)
+            {
+            case Opcode::EQ:
+                line("sete", "%al");
+                line("setnp", "%dl");
+                line("andb", "%dl", "%al");
+                break;
+            case Opcode::NE:
+                line("setne", "%al");
+                line("setp", "%dl");
+                line("orb", "%dl", "%al");
+                break;
+            case Opcode::LT:
+            case Opcode::GT:
+                line("seta", "%al");
+                break;
+            default:
+                line("setae", "%al");
+                break;
+            }
+        }
+        else
+        {
+            static const char *const conditions[] = {"sete", "setne", "setl", "setle", "setg", "setge"};
+            line("movl", where(a), "%eax");
+            line("cmpl", where(b), "%eax");
+            line(conditions[(int)op - (int)Opcode::EQ], "%al");
+        }
+        std::string to = target(id, IrType::BOOL);
+        line("movzbl", "%al", to);
+        store(id, IrType::BOOL, to);
+    }
+
+    void convert(uint32_t id, IrType type, uint32_t a, IrType from)
+    {
+        std::string to = target(id, type);
+        if (isFloating(type))
+        {
+            if (isFloating(from))
+            {
+                line(from == type ? (type == IrType::FLOAT ? "movss" : "movsd") : from == IrType::FLOAT ? "cvtss2sd"
+                                                                                                          : "cvtsd2ss",
+                     where(a), to);
+            }
+            else
+            {
+                line(type == IrType::FLOAT ? "cvtsi2ssl" : "cvtsi2sdl", where(a), to);
+            }
+        }
+        else if (isFloating(from))
+        {
+            if (type == IrType::BOOL)
+            {
+                // NaN is true
+                move(from, where(a), "%xmm15");
+                line("xorps", "%xmm14", "%xmm14");
+                line(from == IrType::FLOAT ? "ucomiss" : "ucomisd", "%xmm14", "%xmm15");
+                line("setne", "%al");
+                line("setp", "%dl");
+                line("orb", "%dl", "%al");
+                line("movzbl", "%al", to);
+            }
+            else
+            {
+                line(from == IrType::FLOAT ? "cvttss2si" : "cvttsd2si", where(a), "%eax");
+                line(type == IrType::CHAR ? "movsbl" : "movl", type == IrType::CHAR ? "%al" : "%eax", to);
+            }
+        }
+        else if (type == IrType::BOOL && from != IrType::BOOL)
+        {
+            line("cmpl", "$0", where(a));
+            line("setne", "%al");
+            line("movzbl", "%al", to);
+        }
+        else if (type == IrType::CHAR && from == IrType::INT)
+        {
+            line("movl", where(a), "%eax");
+            line("movsbl", "%al", to);
+        }
+        else
+        {
+            // bool and char already are valid ints
+            move(type, where(a), to);
+        }
+        store(id, type, to);
+    }
+
+    bool hasPhis(uint32_t block) const
+    {
+        const std::vector<uint32_t> &code = program.getBlocks()[block].code;
+        return !code.empty() && program.at(code[0]).op == Opcode::PHI;
+    }
+
+    /**
+     * Writes the phis of a block with their inputs from 'from'.
+     * They are copied in parallel through the stack, so that no
+     * phi overwrites the input of another. Phis are bools.
+     */
+    void moves(uint32_t from, uint32_t to)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> copies;
+        for (uint32_t id : program.getBlocks()[to].code)
+        {
+            const Instruction &phi = program.at(id);
+            if (phi.op != Opcode::PHI)
+            {
+                break;
+            }
+            const PhiInput *inputs = program.inputsOf(phi);
+            for (uint32_t p = 0; p < phi.args[1]; ++p)
+            {
+                if (inputs[p].block == from && location[inputs[p].value] != location[id])
+                {
+                    copies.push_back({id, inputs[p].value});
+                }
+            }
+        }
+        if (copies.size() == 1)
+        {
+            uint32_t phi = copies[0].first;
+            IrType type = program.at(phi).type;
+            std::string through = inRegister(phi) ? where(phi) : target(phi, type);
+            move(type, where(copies[0].second), through);
+            store(phi, type, through);
+            return;
+        }
+        for (size_t i = 0; i < copies.size(); ++i)
+        {
+            line("movl", where(copies[i].second), "%eax");
+            line("movl", "%eax", std::to_string(parallel + i * 8) + "(%rsp)");
+        }
+        for (size_t i = 0; i < copies.size(); ++i)
+        {
+            line("movl", std::to_string(parallel + i * 8) + "(%rsp)", "%eax");
+            store(copies[i].first, IrType::BOOL, "%eax");
+        }
+    }
+
+    void jump(uint32_t from, uint32_t to)
+    {
+        if (hasPhis(to))
+        {
+            moves(from, to);
+        }
+        if (to != next)
+        {
+            line("jmp", blockLabel(to));
+        }
+    }
+
+    void storeVariables(uint32_t id)
+    {
+        if (firstVariable[id] == IrProgram::NO_VALUE)
+        {
+            return;
+        }
+        const std::vector<IrVariable> &variables = program.getVariables();
+        IrType type = program.at(id).type;
+        std::string from = where(id);
+        if (!inRegister(id))
+        {
+            from = target(id, type);
+            move(type, where(id), from);
+        }
+        for (uint32_t v = firstVariable[id]; v != IrProgram::NO_VALUE; v = nextVariable[v])
+        {
+            move(type, from, "G_" + variables[v].name + "(%rip)");
+        }
+    }
+
+    /**
+     * Constants and the globals of the variables
+     */
+    void data()
+    {
+        code += "\t.section\t.rodata\n\t.align\t16\n";
+        code += ".Lsign32:\n\t.long\t0x80000000, 0, 0, 0\n";
+        code += ".Lsign64:\n\t.quad\t0x8000000000000000, 0\n";
+        std::vector<std::pair<uint64_t, int>> byLabel(constants.size());
+        for (const auto &constant : constants)
+        {
+            byLabel[constant.second] = constant.first;
+        }
+        for (size_t i = 0; i < byLabel.size(); ++i)
+        {
+            code += ".LC" + std::to_string(i) + ":\n\t" + (byLabel[i].second == 4 ? ".long\t" : ".quad\t") +
+                    std::to_string(byLabel[i].first) + "\n";
+        }
+        for (uint32_t id : strings)
+        {
+            // the lexer keeps the escapes as written, as does .string,
+            // except for \" which it turns into a bare quote
+            const std::string &text = program.getStrings().getString(id);
+            code += ".LS" + std::to_string(id) + ":\n\t.string\t\"";
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                if (text[i] == '\\' && i + 1 < text.size())
+                {
+                    code += text[i++];
+                }
+                else if (text[i] == '"')
+                {
+                    code += '\\';
+                }
+                code += text[i];
+            }
+            code += "\"\n";
+        }
+
+        code += "\t.bss\n\t.align\t8\n";
+        for (const IrVariable &variable : program.getVariables())
+        {
+            code += "\t.globl\tG_" + variable.name + "\nG_" + variable.name + ":\n\t.zero\t8\n";
+        }
+    }
+};
+
+#endif // G_ASM_GENERATOR_HPP
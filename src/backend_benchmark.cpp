@@ -0,0 +1,218 @@
+/**
+ * @file    G-Programming-Language/Compiler/backend_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * From source to a running executable: the C++ backend followed by
+ * the host compiler, against the assembly backend.
+ *
+ * Programs of 1k and 10k statements (the first argument changes the
+ * largest) are compiled at -O1. The C++ is built with g++ at -O0
+ * and -O2 (the CXX environment variable changes the compiler), the
+ * assembly with 'as' and 'ld'. The best of several runs is kept for
+ * every step, and for every executable: the size of the file and the
+ * time it takes to run.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "./compiler.hpp"
+
+using namespace std::chrono;
+
+/**
+ * Deterministic generator, so every run builds the same programs
+ */
+struct Random
+{
+    uint64_t state;
+
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (uint32_t)(state >> 33) % bound;
+    }
+};
+
+/**
+ * A straight-line program of ints, floats and booleans, with
+ * nothing the assembly backend does not support
+ *
+ * @param random     generator
+ * @param statements number of statements
+ * @return the source
+ */
+std::string generate(Random &random, int statements)
+{
+    std::stringstream ss;
+    ss << "int i0 = 7;\nfloat f0 = 1.5;\nboolean b0 = true;\n";
+    for (int s = 3; s < statements; ++s)
+    {
+        int i = random.next(s);
+        switch (random.next(4))
+        {
+        case 0:
+            ss << "int i" << s << " = (i0 + " << random.next(100) << ") * (i0 - " << random.next(7) << ") / 3;\n";
+            break;
+        case 1:
+            ss << "float f" << s << " = -f0 * " << random.next(100) << ".5 + i0;\n";
+            break;
+        case 2:
+            ss << "boolean b" << s << " = i0 < " << i << " && !(f0 > 1.0) || b0;\n";
+            break;
+        default:
+            ss << "i0 = i0 % " << 1 + random.next(50) << " + " << i << ";\n";
+            break;
+        }
+    }
+    return ss.str();
+}
+
+/**
+ * Milliseconds a function takes, the best of some runs
+ *
+ * @param runs number of runs
+ * @param work what is measured, returns false if it failed
+ * @return the time, negative if the work failed
+ */
+template <typename Work>
+double best(int runs, Work work)
+{
+    double fastest = -1;
+    for (int r = 0; r < runs; ++r)
+    {
+        auto start = steady_clock::now();
+        if (!work())
+        {
+            return -1;
+        }
+        double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        fastest = fastest < 0 ? ms : std::min(fastest, ms);
+    }
+    return fastest;
+}
+
+/**
+ * Compiles a file with the compiler
+ *
+ * @param path    of the source
+ * @param backend what it is translated to
+ * @return if the compilation succeeded
+ */
+bool compileFile(const std::string &path, CompileOptions::Backend backend)
+{
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, quiet);
+    CompileOptions options;
+    options.level = 1;
+    options.backend = backend;
+    return compile(path, options, context) == SUCCESSFUL_COMPILATION;
+}
+
+/**
+ * Runs an executable
+ *
+ * @param path of the executable
+ * @return if it exited with 0
+ */
+bool execute(const std::string &path)
+{
+    // else the child gets a copy of the rows not yet printed
+    std::fflush(stdout);
+    pid_t child = fork();
+    if (child == 0)
+    {
+        // what a program prints is not part of the measure
+        if (!freopen("/dev/null", "w", stdout))
+        {
+            _exit(127);
+        }
+        execl(path.c_str(), path.c_str(), (char *)nullptr);
+        _exit(127);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * Size of a file in KB
+ */
+double kilobytes(const std::string &path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? info.st_size / 1024.0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    int largest = argc > 1 ? std::max(1000, atoi(argv[1])) : 10000;
+    const char *cxx = std::getenv("CXX");
+    std::string compiler = cxx ? cxx : "g++";
+    const int runs = 3;
+
+    char directory[] = "/tmp/g_backend_benchmark_XXXXXX";
+    if (!mkdtemp(directory))
+    {
+        std::cerr << "[!] Cannot create a temporary directory.\n";
+        return EXIT_FAILURE;
+    }
+    std::printf("%10s %-22s %10s %10s %10s\n", "statements", "path", "build ms", "run ms", "KB");
+    Random random = {43};
+    bool failed = false;
+    for (int statements = 1000; statements <= largest && !failed; statements *= 10)
+    {
+        std::string base = std::string(directory) + "/p" + std::to_string(statements);
+        std::ofstream(base + ".g") << generate(random, statements);
+
+        double cpp = best(runs, [&] { return compileFile(base + ".g", CompileOptions::Backend::CPP); });
+        std::printf("%10d %-22s %10.1f\n", statements, "gc (C++ out)", cpp);
+        for (const char *level : {"-O0", "-O2"})
+        {
+            std::string executable = base + level;
+            std::string command = compiler + " " + level + " -o " + shellQuote(executable) + " " +
+                                  shellQuote(base + ".cpp");
+            double ms = best(runs, [&] { return std::system(command.c_str()) == 0; });
+            double run = best(runs, [&] { return execute(executable); });
+            std::printf("%10d %-22s %10.1f %10.2f %10.1f\n", statements, (" + " + compiler + " " + level).c_str(),
+                        cpp + ms, run, kilobytes(executable));
+            failed = failed || ms < 0 || run < 0;
+            std::remove(executable.c_str());
+        }
+
+        double assembly = best(runs, [&] { return compileFile(base + ".g", CompileOptions::Backend::ASM); });
+        std::string link = "as -o " + shellQuote(base + ".o") + " " + shellQuote(base + ".s") + " && ld -o " +
+                           shellQuote(base) + " " + shellQuote(base + ".o");
+        double assembler = best(runs, [&] { return std::system(link.c_str()) == 0; });
+        double run = best(runs, [&] { return execute(base); });
+        std::printf("%10d %-22s %10.1f %10.2f %10.1f\n", statements, "gc --backend=asm", assembly, run,
+                    kilobytes(base));
+        std::printf("%10d %-22s %10.1f\n", statements, "  of which as + ld", assembler);
+        failed = failed || cpp < 0 || assembly < 0 || assembler < 0 || run < 0;
+
+        for (const char *output : {".g", ".cpp", ".s", ".o", ""})
+        {
+            std::remove((base + output).c_str());
+        }
+    }
+    rmdir(directory);
+    if (failed)
+    {
+        std::cerr << "[!] A build or a run failed.\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
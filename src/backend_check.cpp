@@ -0,0 +1,252 @@
+/**
+ * @file    G-Programming-Language/Compiler/backend_check.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * The backends that run a program must agree on what it does.
+ *
+ * Every program is run by the JIT (--run) at -O0, -O1 and -O2, by
+ * the virtual machine of gvm and, at -O2, as the executable of the
+ * assembly backend. Either all of them stop it, or all of them
+ * complete it and the first two print the same values (the
+ * executable prints nothing). A stopped program must be reported
+ * as such by the compiler. The programs are a few divisions by 0
+ * and -1, INT_MIN / -1 among them, then random ones (200 by
+ * default, the first argument changes it) that divide by such
+ * values.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "./bytecode.hpp"
+#include "./compiler.hpp"
+#include "./vm.hpp"
+
+/**
+ * Deterministic generator, so every run checks the same programs
+ */
+struct Random
+{
+    uint64_t state;
+
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (uint32_t)(state >> 33) % bound;
+    }
+};
+
+/**
+ * A program of ints that divides by 0, -1 and INT_MIN often
+ *
+ * @param random generator
+ * @return the source
+ */
+std::string generate(Random &random)
+{
+    static const char *const operands[] = {"0", "1", "(0 - 1)", "2", "7", "2147483647", "(0 - 2147483647 - 1)"};
+    static const char *const operators[] = {"+", "-", "*", "/", "%", "/", "%"};
+    std::stringstream ss;
+    ss << "int v0 = 0 - 2147483647 - 1;\n";
+    int statements = 2 + random.next(8);
+    for (int s = 1; s < statements; ++s)
+    {
+        std::string lhs = random.next(2) ? "v" + std::to_string(random.next(s)) : operands[random.next(7)];
+        std::string rhs = random.next(2) ? "v" + std::to_string(random.next(s)) : operands[random.next(7)];
+        ss << "int v" << s << " = " << lhs << " " << operators[random.next(7)] << " " << rhs << ";\n";
+    }
+    return ss.str();
+}
+
+/**
+ * What a backend did with a program
+ */
+struct Outcome
+{
+    bool stopped;
+    std::string values;
+
+    bool operator==(const Outcome &other) const
+    {
+        return stopped == other.stopped && (stopped || values == other.values);
+    }
+};
+
+/**
+ * Runs a program with the JIT
+ *
+ * @param path  of the source file
+ * @param level optimisation level
+ * @return what the program did
+ */
+Outcome runJit(const std::string &path, int level)
+{
+    std::stringstream out;
+    std::stringstream err;
+    CompilationContext context(out, err);
+    CompileOptions options;
+    options.level = level;
+    options.run = true;
+    int code = compile(path, options, context);
+    if (code != SUCCESSFUL_COMPILATION && code != PROGRAM_STOPPED)
+    {
+        std::cerr << "[!] " << path << " not run at -O" << level << ": " << err.str();
+        std::exit(EXIT_FAILURE);
+    }
+    if (code == PROGRAM_STOPPED && err.str().find("stopped by a division") == std::string::npos)
+    {
+        std::cerr << "[!] " << path << " stopped at -O" << level << " without saying why: " << err.str();
+        std::exit(EXIT_FAILURE);
+    }
+    // the values are what the compiler prints between running the program and its report
+    std::string values;
+    std::string line;
+    bool running = false;
+    while (std::getline(out, line))
+    {
+        if (running && !line.empty() && line[0] == '[')
+        {
+            break;
+        }
+        if (running)
+        {
+            values += line + "\n";
+        }
+        running = running || line == "[8] Running...";
+    }
+    return {code == PROGRAM_STOPPED, values};
+}
+
+/**
+ * Builds a program with the assembly backend and runs the
+ * executable
+ *
+ * @param path of the source file, the executable is written next to it
+ * @return if the program was stopped, by the trap of a division
+ */
+bool stoppedAsm(const std::string &path)
+{
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, quiet);
+    CompileOptions options;
+    options.backend = CompileOptions::Backend::ASM;
+    std::string executable = path.substr(0, path.size() - 2);
+    if (compile(path, options, context) != SUCCESSFUL_COMPILATION)
+    {
+        std::cerr << "[!] " << path << " not built with the assembly backend.\n";
+        std::exit(EXIT_FAILURE);
+    }
+    pid_t child = fork();
+    if (child == 0)
+    {
+        execl(executable.c_str(), executable.c_str(), (char *)nullptr);
+        _exit(127);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGFPE;
+}
+
+/**
+ * Runs a program in the virtual machine, as gvm does
+ *
+ * @param source of the program
+ * @return what the program did
+ */
+Outcome runVm(const std::string &source)
+{
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, quiet);
+    Lexer lexer(context, source);
+    std::vector<Token> tokens = lexer.lex();
+    Parser parser(context, tokens);
+    std::shared_ptr<ParseTreeNode> tree = parser.parse(1);
+    Bytecode bytecode;
+    BytecodeCompiler compiler(*parser.getSymbolTable());
+    if (!parser.isValid() || !compiler.compile(tree, bytecode))
+    {
+        std::cerr << "[!] Bytecode not generated for:\n" << source;
+        std::exit(EXIT_FAILURE);
+    }
+    VirtualMachine vm(bytecode.image());
+    std::stringstream values;
+    bool completed = vm.run();
+    if (completed)
+    {
+        vm.printValues(values);
+    }
+    return {!completed, values.str()};
+}
+
+int main(int argc, char *argv[])
+{
+    const int randomPrograms = argc > 1 ? std::max(0, atoi(argv[1])) : 200;
+    std::vector<std::string> programs = {
+        "int a = 0 - 2147483647 - 1;\nint b = 0 - 1;\nint c = a / b;\nint d = a % b;\n",
+        "int a = 0 - 2147483647 - 1;\nint b = 0 - 1;\nint d = a % b;\n",
+        "int a = 0 - 2147483647 - 1;\nint c = a / (0 - 1);\nc = 1;\n",
+        "int a = 7;\nint b = 0;\nint c = a / b;\n",
+        "int a = 7;\nint b = 0;\nint c = a % b;\nc = 1;\n",
+        "int a = 0 - 2147483647 - 1;\nint b = a / 1;\nint c = a / 2;\nint d = a % 2;\nint e = 7 / (0 - 1);\n",
+        "int a = 0 - 2147483647;\nint b = 0 - 1;\nint c = a / b;\nint d = a % b;\n"};
+    Random random = {45};
+    for (int p = 0; p < randomPrograms; ++p)
+    {
+        programs.push_back(generate(random));
+    }
+
+    char directory[] = "/tmp/g_backend_check_XXXXXX";
+    if (!mkdtemp(directory))
+    {
+        std::cerr << "[!] Cannot create a temporary directory.\n";
+        return EXIT_FAILURE;
+    }
+    std::string path = std::string(directory) + "/program.g";
+    int stopped = 0;
+    int mismatches = 0;
+    for (const std::string &program : programs)
+    {
+        std::ofstream(path) << program;
+        Outcome vm = runVm(program);
+        stopped += vm.stopped;
+        for (int level = 0; level <= 2; ++level)
+        {
+            Outcome jit = runJit(path, level);
+            if (!(jit == vm))
+            {
+                ++mismatches;
+                std::cerr << "[!] The JIT at -O" << level << (jit.stopped ? " stops" : " completes")
+                          << " and the VM" << (vm.stopped ? " stops" : " completes") << ":\n"
+                          << program << "JIT:\n" << jit.values << "VM:\n" << vm.values;
+            }
+        }
+        if (stoppedAsm(path) != vm.stopped)
+        {
+            ++mismatches;
+            std::cerr << "[!] The executable" << (vm.stopped ? " completes" : " stops") << " and the VM"
+                      << (vm.stopped ? " stops" : " completes") << ":\n"
+                      << program;
+        }
+    }
+    for (const char *output : {"/program.g", "/program.cpp", "/program.s", "/program.o", "/program"})
+    {
+        std::remove((directory + std::string(output)).c_str());
+    }
+    rmdir(directory);
+
+    std::cout << programs.size() << " programs, " << stopped << " stopped, " << mismatches << " mismatches\n";
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,902 @@
+/**
+ * @file    G-Programming-Language/Compiler/bytecode.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_BYTECODE_HPP
+#define G_BYTECODE_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "./interner.hpp"
+#include "./ir.hpp"
+#include "./parser_new.hpp"
+#include "./symbols.hpp"
+
+/**
+ * Instructions of the virtual machine. Operands are registers
+ * unless noted: 'a' is the destination, 'b' and 'c' the sources.
+ * The suffix is the type the instruction works on: I int (bools
+ * and chars are ints), F float, D double, S string.
+ */
+enum class BcOp : uint8_t
+{
+    /**
+     * a = b
+     */
+    MOVE,
+    /**
+     * a = constants[bx]
+     */
+    LOADK,
+    /**
+     * a = bx, a signed int that fits in the operand
+     */
+    LOADI,
+    /**
+     * a = the string at offset bx of the string table
+     */
+    LOADS,
+    ADDI,
+    SUBI,
+    MULI,
+    DIVI,
+    MODI,
+    ANDI,
+    ORI,
+    XORI,
+    NEGI,
+    /**
+     * a = !b, on a bool
+     */
+    NOTB,
+    EQI,
+    NEI,
+    LTI,
+    LEI,
+    GTI,
+    GEI,
+    ADDF,
+    SUBF,
+    MULF,
+    DIVF,
+    NEGF,
+    EQF,
+    NEF,
+    LTF,
+    LEF,
+    GTF,
+    GEF,
+    ADDD,
+    SUBD,
+    MULD,
+    DIVD,
+    NEGD,
+    EQD,
+    NED,
+    LTD,
+    LED,
+    GTD,
+    GED,
+    ADDS,
+    EQS,
+    NES,
+    LTS,
+    LES,
+    GTS,
+    GES,
+    /**
+     * Conversions, named source 2 target: B bool, C char
+     */
+    I2C,
+    I2B,
+    I2F,
+    I2D,
+    F2I,
+    F2B,
+    F2D,
+    D2I,
+    D2B,
+    D2F,
+    /**
+     * Jump to bx
+     */
+    JMP,
+    /**
+     * Jump to bx if a is false
+     */
+    JMPF,
+    /**
+     * Jump to bx if a is true
+     */
+    JMPT,
+    RET
+};
+
+inline const char *bcOpName(BcOp op)
+{
+    static const char *const names[] = {
+        "move", "loadk", "loadi", "loads", "addi", "subi", "muli", "divi", "modi", "andi", "ori", "xori", "negi", "notb",
+        "eqi", "nei", "lti", "lei", "gti", "gei", "addf", "subf", "mulf", "divf", "negf", "eqf", "nef", "ltf",
+        "lef", "gtf", "gef", "addd", "subd", "muld", "divd", "negd", "eqd", "ned", "ltd", "led", "gtd", "ged",
+        "adds", "eqs", "nes", "lts", "les", "gts", "ges", "i2c", "i2b", "i2f", "i2d", "f2i", "f2b", "f2d", "d2i",
+        "d2b", "d2f", "jmp", "jmpf", "jmpt", "ret"};
+    return names[(int)op];
+}
+
+/**
+ * A string of the machine: its length, then its chars and a NUL,
+ * padded to a multiple of 8 bytes. The strings of a program are
+ * records of its string table, the ones made while running are
+ * allocated by the machine.
+ */
+struct BcString
+{
+    uint32_t size;
+    uint32_t reserved;
+
+    const char *chars() const
+    {
+        return reinterpret_cast<const char *>(this + 1);
+    }
+
+    /**
+     * Words the record of a string takes
+     *
+     * @param size of the string
+     */
+    static size_t words(size_t size)
+    {
+        return 1 + (size + 1 + 7) / 8;
+    }
+};
+
+/**
+ * Content of a register or of a constant. Which member is set
+ * is known from the instructions that use it.
+ */
+union BcValue
+{
+    int32_t i;
+    float f;
+    double d;
+    const BcString *s;
+};
+
+/**
+ * A variable and the register that holds it. The layout is fixed,
+ * files store it as it is.
+ */
+struct BcVariable
+{
+    /**
+     * Offset of its name in the string table
+     */
+    uint32_t name;
+    uint32_t reg;
+    IrType type;
+
+    /**
+     * If the program assigns it a value
+     */
+    uint8_t assigned;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(BcVariable) == 12, "BcVariable is stored in files as it is");
+
+/**
+ * Instruction encoding: every instruction is one 64 bit word, the
+ * opcode in the low 8 bits, then three 18 bit operands a, b and c;
+ * b and c together are bx, an operand of 36 bits.
+ */
+struct BcWord
+{
+    static const unsigned OPERAND_BITS = 18;
+    static const uint32_t MAX_OPERAND = (1u << OPERAND_BITS) - 1;
+
+    static uint64_t encode(BcOp op, uint32_t a, uint32_t b = 0, uint32_t c = 0)
+    {
+        return (uint64_t)op | (uint64_t)a << 8 | (uint64_t)b << (8 + OPERAND_BITS) |
+               (uint64_t)c << (8 + 2 * OPERAND_BITS);
+    }
+
+    static uint64_t encodeX(BcOp op, uint32_t a, int64_t bx)
+    {
+        return (uint64_t)op | (uint64_t)a << 8 | (uint64_t)bx << (8 + OPERAND_BITS);
+    }
+
+    static BcOp opOf(uint64_t word)
+    {
+        return (BcOp)(word & 0xFF);
+    }
+
+    static uint32_t aOf(uint64_t word)
+    {
+        return (uint32_t)(word >> 8) & MAX_OPERAND;
+    }
+
+    static uint32_t bOf(uint64_t word)
+    {
+        return (uint32_t)(word >> (8 + OPERAND_BITS)) & MAX_OPERAND;
+    }
+
+    static uint32_t cOf(uint64_t word)
+    {
+        return (uint32_t)(word >> (8 + 2 * OPERAND_BITS)) & MAX_OPERAND;
+    }
+
+    static int64_t bxOf(uint64_t word)
+    {
+        // arithmetic shift: LOADI keeps the sign
+        return (int64_t)word >> (8 + OPERAND_BITS);
+    }
+
+    /**
+     * Number of register operands of an instruction
+     */
+    static int registersOf(BcOp op)
+    {
+        switch (op)
+        {
+        case BcOp::LOADK:
+        case BcOp::LOADI:
+        case BcOp::LOADS:
+        case BcOp::JMPF:
+        case BcOp::JMPT:
+            return 1;
+        case BcOp::JMP:
+        case BcOp::RET:
+            return 0;
+        case BcOp::MOVE:
+        case BcOp::NEGI:
+        case BcOp::NOTB:
+        case BcOp::NEGF:
+        case BcOp::NEGD:
+            return 2;
+        default:
+            return op >= BcOp::I2C ? 2 : 3;
+        }
+    }
+};
+
+/**
+ * A program ready to run. It only points to its sections, which
+ * may be the vectors of a Bytecode or a mapped file.
+ */
+struct BcImage
+{
+    const uint64_t *code;
+    uint32_t codeSize;
+
+    /**
+     * Constant pool, loaded by LOADK: numbers only
+     */
+    const BcValue *constants;
+    uint32_t constantCount;
+
+    /**
+     * String table: the records of the string constants and of the
+     * names of the variables, addressed by their offset in words
+     */
+    const uint64_t *strings;
+    uint32_t stringWords;
+
+    const BcVariable *variables;
+    uint32_t variableCount;
+
+    /**
+     * Number of registers the program uses
+     */
+    uint32_t registers;
+
+    const BcString *string(uint32_t offset) const
+    {
+        return reinterpret_cast<const BcString *>(strings + offset);
+    }
+
+    /**
+     * Prints the program, one instruction per line
+     *
+     * @param out stream to print to
+     */
+    void disassemble(std::ostream &out) const
+    {
+        out << "; " << registers << " registers, " << constantCount << " constants, " << stringWords * 8
+            << " bytes of strings\n";
+        for (uint32_t v = 0; v < variableCount; ++v)
+        {
+            const BcVariable &variable = variables[v];
+            out << "; r" << variable.reg << " " << string(variable.name)->chars() << " "
+                << irTypeName(variable.type) << "\n";
+        }
+        for (uint32_t pc = 0; pc < codeSize; ++pc)
+        {
+            uint64_t word = code[pc];
+            BcOp op = BcWord::opOf(word);
+            out << pc << "\t" << bcOpName(op);
+            switch (op)
+            {
+            case BcOp::LOADK:
+            case BcOp::LOADI:
+            case BcOp::JMPF:
+            case BcOp::JMPT:
+                out << " r" << BcWord::aOf(word) << ", " << (op == BcOp::LOADK ? "k" : "") << BcWord::bxOf(word);
+                break;
+            case BcOp::LOADS:
+                out << " r" << BcWord::aOf(word) << ", \"" << string((uint32_t)BcWord::bxOf(word))->chars() << "\"";
+                break;
+            case BcOp::JMP:
+                out << " " << BcWord::bxOf(word);
+                break;
+            case BcOp::RET:
+                break;
+            default:
+                out << " r" << BcWord::aOf(word) << ", r" << BcWord::bOf(word);
+                if (BcWord::registersOf(op) == 3)
+                {
+                    out << ", r" << BcWord::cOf(word);
+                }
+                break;
+            }
+            out << "\n";
+        }
+    }
+};
+
+/**
+ * A compiled program, the owner of its sections
+ */
+struct Bytecode
+{
+    std::vector<uint64_t> code;
+
+    std::vector<BcValue> constants;
+
+    std::vector<uint64_t> strings;
+
+    std::vector<BcVariable> variables;
+
+    uint32_t registers = 0;
+
+    /**
+     * Appends a record to the string table
+     *
+     * @param text of the string
+     * @return its offset
+     */
+    uint32_t addString(const std::string &text)
+    {
+        uint32_t offset = (uint32_t)strings.size();
+        strings.resize(strings.size() + BcString::words(text.size()), 0);
+        BcString *record = reinterpret_cast<BcString *>(&strings[offset]);
+        record->size = (uint32_t)text.size();
+        std::memcpy(const_cast<char *>(record->chars()), text.data(), text.size());
+        return offset;
+    }
+
+    BcImage image() const
+    {
+        return {code.data(), (uint32_t)code.size(), constants.data(), (uint32_t)constants.size(),
+                strings.data(), (uint32_t)strings.size(), variables.data(), (uint32_t)variables.size(), registers};
+    }
+};
+
+/**
+ * Compiles a parse tree to bytecode, with no detour through SSA
+ * form: every variable gets a register of its own and the
+ * temporaries of an expression are allocated like a stack above
+ * them, so a program needs as many registers as it has variables
+ * plus the depth of its deepest expression. The types and the
+ * implicit conversions are the ones of IrBuilder.
+ */
+class BytecodeCompiler
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param symbols of the program
+     */
+    explicit BytecodeCompiler(const FrozenSymbolTable &symbols) : symbols(symbols) {}
+
+    /**
+     * Compiles a program
+     *
+     * @param tree     root of a valid parse tree, from Parser::parse
+     * @param bytecode where the program is written
+     * @return false if it cannot be compiled, see getError
+     */
+    bool compile(const std::shared_ptr<ParseTreeNode> &tree, Bytecode &bytecode)
+    {
+        out = &bytecode;
+        auto root = std::static_pointer_cast<NonTerminalNode>(tree);
+        // the variables come first, in the order they are declared
+        for (const auto &child : root->getChildren())
+        {
+            auto node = std::static_pointer_cast<NonTerminalNode>(
+                std::static_pointer_cast<NonTerminalNode>(child)->getChildren().at(0));
+            if (node->getLabel() == "declaration")
+            {
+                node = std::static_pointer_cast<NonTerminalNode>(node->getChildren().at(0));
+                std::string name = node->getValue(1);
+                IrType type = irTypeOf(symbols.typeOf(name));
+                if (type == IrType::VOID)
+                {
+                    return fail("the type of '" + name + "' is not supported", node->getChildren()[1]);
+                }
+                names.intern(name);
+                out->variables.push_back({intern(name), (uint32_t)out->variables.size(), type, false, 0});
+            }
+        }
+        top = (uint32_t)out->variables.size();
+        out->registers = top;
+
+        for (const auto &child : root->getChildren())
+        {
+            auto node = std::static_pointer_cast<NonTerminalNode>(
+                std::static_pointer_cast<NonTerminalNode>(child)->getChildren().at(0));
+            size_t expression = 1;
+            if (node->getLabel() == "declaration")
+            {
+                node = std::static_pointer_cast<NonTerminalNode>(node->getChildren().at(0));
+                expression = 2;
+            }
+            if (node->getChildren().size() <= expression)
+            {
+                continue;
+            }
+            BcVariable &variable = out->variables[names.find(node->getValue(expression - 1))];
+            variable.assigned = true;
+            if (!store(node->getChildren()[expression], variable))
+            {
+                return false;
+            }
+        }
+        out->code.push_back(BcWord::encode(BcOp::RET, 0));
+        return error.empty();
+    }
+
+    /**
+     * Why the program could not be compiled
+     */
+    const std::string &getError() const
+    {
+        return error;
+    }
+
+private:
+    /**
+     * Result of an expression: the register it is in and its type
+     */
+    struct Operand
+    {
+        uint32_t reg;
+        IrType type;
+    };
+
+    static const uint32_t ANY = UINT32_MAX;
+
+    const FrozenSymbolTable &symbols;
+
+    Bytecode *out = nullptr;
+
+    StringInterner names;
+
+    /**
+     * First free temporary register
+     */
+    uint32_t top = 0;
+
+    /**
+     * Constants already in the pool: type and bits
+     */
+    std::map<std::pair<int, uint64_t>, uint32_t> pool;
+
+    /**
+     * Strings already in the string table
+     */
+    std::map<std::string, uint32_t> interned;
+
+    std::string error;
+
+    bool fail(const std::string &why, const std::shared_ptr<ParseTreeNode> &node)
+    {
+        if (error.empty())
+        {
+            auto terminal = std::dynamic_pointer_cast<TerminalNode>(node);
+            error = why + (terminal ? " (line " + std::to_string(terminal->getLine()) + ")" : "");
+        }
+        return false;
+    }
+
+    uint32_t temporary()
+    {
+        if (top > BcWord::MAX_OPERAND)
+        {
+            if (error.empty())
+            {
+                error = "more than " + std::to_string(BcWord::MAX_OPERAND) + " registers";
+            }
+            return 0;
+        }
+        out->registers = std::max(out->registers, top + 1);
+        return top++;
+    }
+
+    uint32_t destination(uint32_t target)
+    {
+        return target == ANY ? temporary() : target;
+    }
+
+    void emit(BcOp op, uint32_t a, uint32_t b = 0, uint32_t c = 0)
+    {
+        out->code.push_back(BcWord::encode(op, a, b, c));
+    }
+
+    bool store(const std::shared_ptr<ParseTreeNode> &expression, const BcVariable &variable)
+    {
+        const auto &root = static_cast<NonTerminalNode &>(*expression).getChildren().at(0);
+        auto terminal = dynamic_cast<TerminalNode *>(root.get());
+        uint32_t mark = top;
+        if (terminal && terminal->getType() == TokenType::NULL_KEYWORD)
+        {
+            // the value initialised type
+            if (variable.type == IrType::STRING)
+            {
+                loadString("", variable.reg);
+            }
+            else
+            {
+                BcValue zero = {};
+                zero.d = 0;
+                load(variable.type, zero, variable.reg);
+            }
+            return true;
+        }
+        Operand value = lower(root, variable.type, variable.reg);
+        if (value.type != IrType::VOID)
+        {
+            convert(value, variable.type, variable.reg, root);
+        }
+        top = mark;
+        return error.empty();
+    }
+
+    /**
+     * Offset of a string in the string table, added if it is not
+     * there yet
+     */
+    uint32_t intern(const std::string &text)
+    {
+        auto it = interned.find(text);
+        if (it != interned.end())
+        {
+            return it->second;
+        }
+        return interned[text] = out->addString(text);
+    }
+
+    Operand loadString(const std::string &text, uint32_t target)
+    {
+        uint32_t reg = destination(target);
+        out->code.push_back(BcWord::encodeX(BcOp::LOADS, reg, intern(text)));
+        return {reg, IrType::STRING};
+    }
+
+    /**
+     * Loads a constant, inline if it is a small int
+     */
+    Operand load(IrType type, BcValue value, uint32_t target)
+    {
+        uint32_t reg = destination(target);
+        bool isInt = type == IrType::BOOL || type == IrType::CHAR || type == IrType::INT;
+        if (isInt)
+        {
+            out->code.push_back(BcWord::encodeX(BcOp::LOADI, reg, value.i));
+            return {reg, type};
+        }
+        if (type == IrType::FLOAT)
+        {
+            // no stray bits above the float, in the key or in files
+            float real = value.f;
+            value.d = 0;
+            value.f = real;
+        }
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(value));
+        auto it = pool.find({(int)type, bits});
+        if (it == pool.end())
+        {
+            it = pool.insert({{(int)type, bits}, (uint32_t)out->constants.size()}).first;
+            out->constants.push_back(value);
+        }
+        out->code.push_back(BcWord::encodeX(BcOp::LOADK, reg, it->second));
+        return {reg, type};
+    }
+
+    /**
+     * Converts an operand, as C++ does implicitly
+     *
+     * @param value  to convert
+     * @param type   to convert to
+     * @param target register of the result, ANY for a temporary
+     * @return the converted value
+     */
+    Operand convert(Operand value, IrType type, uint32_t target, const std::shared_ptr<ParseTreeNode> &node)
+    {
+        IrType from = value.type;
+        if (from == type || (promote(from) == IrType::INT && type == IrType::INT))
+        {
+            // bools and chars are valid ints already
+            if (target != ANY && target != value.reg)
+            {
+                emit(BcOp::MOVE, target, value.reg);
+                value.reg = target;
+            }
+            return {value.reg, type};
+        }
+        if (from == IrType::STRING || type == IrType::STRING)
+        {
+            fail(std::string("cannot convert ") + irTypeName(from) + " to " + irTypeName(type), node);
+            return {0, IrType::VOID};
+        }
+        uint32_t reg = destination(target);
+        bool fromInt = promote(from) == IrType::INT;
+        switch (type)
+        {
+        case IrType::BOOL:
+            emit(fromInt ? BcOp::I2B : from == IrType::FLOAT ? BcOp::F2B
+                                                             : BcOp::D2B,
+                 reg, value.reg);
+            break;
+        case IrType::CHAR:
+            if (!fromInt)
+            {
+                emit(from == IrType::FLOAT ? BcOp::F2I : BcOp::D2I, reg, value.reg);
+                value.reg = reg;
+            }
+            emit(BcOp::I2C, reg, value.reg);
+            break;
+        case IrType::INT:
+            emit(from == IrType::FLOAT ? BcOp::F2I : BcOp::D2I, reg, value.reg);
+            break;
+        case IrType::FLOAT:
+            emit(fromInt ? BcOp::I2F : BcOp::D2F, reg, value.reg);
+            break;
+        default:
+            emit(fromInt ? BcOp::I2D : BcOp::F2D, reg, value.reg);
+            break;
+        }
+        return {reg, type};
+    }
+
+    /**
+     * Compiles an expression
+     *
+     * @param node   root of the expression
+     * @param type   the result is converted to, a hint: if it is
+     *               not the type of the expression, 'target' is
+     *               not written
+     * @param target register the result should go to, ANY for a
+     *               temporary. It is written by the last instruction
+     *               only, so the expression may read it.
+     * @return the result, of type VOID after an error
+     */
+    Operand lower(const std::shared_ptr<ParseTreeNode> &node, IrType type, uint32_t target)
+    {
+        if (auto terminal = dynamic_cast<TerminalNode *>(node.get()))
+        {
+            return lowerTerminal(*terminal, node, type, target);
+        }
+        uint32_t mark = top;
+        if (auto unary = dynamic_cast<UnaryNode *>(node.get()))
+        {
+            Operand operand = lower(unary->getOperand(), IrType::VOID, ANY);
+            if (operand.type == IrType::VOID)
+            {
+                return operand;
+            }
+            if (unary->getOperator() == TokenType::NOT_LOGIC)
+            {
+                operand = convert(operand, IrType::BOOL, ANY, node);
+                top = mark;
+                uint32_t reg = destination(type == IrType::BOOL ? target : ANY);
+                emit(BcOp::NOTB, reg, operand.reg);
+                return {reg, IrType::BOOL};
+            }
+            IrType result = promote(operand.type);
+            if (result == IrType::STRING)
+            {
+                fail("cannot negate a string", node);
+                return {0, IrType::VOID};
+            }
+            operand = convert(operand, result, ANY, node);
+            top = mark;
+            uint32_t reg = destination(type == result ? target : ANY);
+            emit(result == IrType::INT ? BcOp::NEGI : result == IrType::FLOAT ? BcOp::NEGF
+                                                                               : BcOp::NEGD,
+                 reg, operand.reg);
+            return {reg, result};
+        }
+
+        auto binary = static_cast<BinaryNode *>(node.get());
+        TokenType op = binary->getOperator();
+        if (op == TokenType::AND_CONDITIONAL || op == TokenType::OR_CONDITIONAL)
+        {
+            return lowerConditional(*binary, node, type, target);
+        }
+        Operand lhs = lower(binary->getLhs(), IrType::VOID, ANY);
+        Operand rhs = lower(binary->getRhs(), IrType::VOID, ANY);
+        if (lhs.type == IrType::VOID || rhs.type == IrType::VOID)
+        {
+            return {0, IrType::VOID};
+        }
+        IrType common = commonType(promote(lhs.type), promote(rhs.type));
+        lhs = convert(lhs, common, ANY, node);
+        rhs = convert(rhs, common, ANY, node);
+        if (lhs.type == IrType::VOID || rhs.type == IrType::VOID)
+        {
+            return {0, IrType::VOID};
+        }
+        BcOp opcode;
+        IrType result;
+        if (!select(op, common, opcode, result))
+        {
+            fail(std::string("operator not defined on ") + irTypeName(common), node);
+            return {0, IrType::VOID};
+        }
+        top = mark;
+        uint32_t reg = destination(type == result ? target : ANY);
+        emit(opcode, reg, lhs.reg, rhs.reg);
+        return {reg, result};
+    }
+
+    /**
+     * Opcode of a binary operator on a type, and the type of its
+     * result
+     */
+    static bool select(TokenType op, IrType type, BcOp &opcode, IrType &result)
+    {
+        static const TokenType comparisons[] = {TokenType::EQUAL, TokenType::NOT_EQUAL, TokenType::LOWER,
+                                                TokenType::LOWER_EQUAL, TokenType::GREATER, TokenType::GREATER_EQUAL};
+        static const BcOp first[] = {BcOp::EQI, BcOp::EQF, BcOp::EQD, BcOp::EQS};
+        int column = type == IrType::INT ? 0 : type == IrType::FLOAT ? 1
+                                           : type == IrType::DOUBLE  ? 2
+                                                                     : 3;
+        for (int c = 0; c < 6; ++c)
+        {
+            if (op == comparisons[c])
+            {
+                opcode = (BcOp)((int)first[column] + c);
+                result = IrType::BOOL;
+                return true;
+            }
+        }
+        result = type;
+        static const TokenType arithmetic[] = {TokenType::PLUS, TokenType::MINUS, TokenType::MULTIPLY,
+                                               TokenType::DIVIDE, TokenType::MODULO, TokenType::AND_LOGIC,
+                                               TokenType::OR_LOGIC, TokenType::XOR_LOGIC};
+        static const BcOp firstArithmetic[] = {BcOp::ADDI, BcOp::ADDF, BcOp::ADDD, BcOp::ADDS};
+        // float and double have the first four, strings only '+'
+        int count = column == 0 ? 8 : column == 3 ? 1
+                                                  : 4;
+        for (int a = 0; a < count; ++a)
+        {
+            if (op == arithmetic[a])
+            {
+                opcode = (BcOp)((int)firstArithmetic[column] + a);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * '&&' and '||' skip their right operand when the left one
+     * decides the result:
+     *
+     *     t = bool(lhs); jmpf t, end   (jmpt for '||')
+     *     t = bool(rhs)
+     *     end:
+     *
+     * 't' is a temporary, since the right operand may read the
+     * target; the result is moved there at the end.
+     */
+    Operand lowerConditional(const BinaryNode &binary, const std::shared_ptr<ParseTreeNode> &node, IrType type,
+                             uint32_t target)
+    {
+        uint32_t mark = top;
+        uint32_t reg = temporary();
+        Operand lhs = lower(binary.getLhs(), IrType::BOOL, reg);
+        if (lhs.type == IrType::VOID)
+        {
+            return lhs;
+        }
+        convert(lhs, IrType::BOOL, reg, node);
+        top = reg + 1;
+        size_t jump = out->code.size();
+        emit(binary.getOperator() == TokenType::AND_CONDITIONAL ? BcOp::JMPF : BcOp::JMPT, reg);
+        Operand rhs = lower(binary.getRhs(), IrType::BOOL, reg);
+        if (rhs.type == IrType::VOID)
+        {
+            return rhs;
+        }
+        convert(rhs, IrType::BOOL, reg, node);
+        BcOp op = BcWord::opOf(out->code[jump]);
+        out->code[jump] = BcWord::encodeX(op, reg, (int64_t)out->code.size());
+        top = mark;
+        if (type == IrType::BOOL && target != ANY)
+        {
+            emit(BcOp::MOVE, target, reg);
+            return {target, IrType::BOOL};
+        }
+        top = reg + 1;
+        return {reg, IrType::BOOL};
+    }
+
+    Operand lowerTerminal(TerminalNode &terminal, const std::shared_ptr<ParseTreeNode> &node, IrType type,
+                          uint32_t target)
+    {
+        const std::string &value = terminal.getValue();
+        BcValue constant = {};
+        IrType result = IrType::INT;
+        switch (terminal.getType())
+        {
+        case TokenType::TRUE:
+        case TokenType::FALSE:
+            constant.i = terminal.getType() == TokenType::TRUE;
+            result = IrType::BOOL;
+            break;
+        case TokenType::INT_LITERAL:
+        {
+            ConstValue v = intValue(value);
+            if (v.isConstant() && v.integer != (int32_t)v.integer)
+            {
+                fail("integers wider than an int are not supported", node);
+                return {0, IrType::VOID};
+            }
+            constant.i = v.isConstant() ? (int32_t)v.integer : 0;
+            break;
+        }
+        case TokenType::FLOAT_LITERAL:
+            constant.d = std::strtod(value.c_str(), nullptr);
+            result = IrType::DOUBLE;
+            break;
+        case TokenType::CHAR_LITERAL:
+        {
+            ConstValue v = charValue(value);
+            constant.i = v.isConstant() ? (int32_t)v.integer : 0;
+            result = IrType::CHAR;
+            break;
+        }
+        case TokenType::STRING_LITERAL:
+            return loadString(stringValue(value), type == IrType::STRING ? target : ANY);
+        case TokenType::IDENTIFIER:
+        {
+            // variables are read where they are
+            const BcVariable &variable = out->variables[names.find(value)];
+            return {variable.reg, variable.type};
+        }
+        default:
+            // NULL inside an expression is the integer 0
+            break;
+        }
+        return load(result, constant, type == result ? target : ANY);
+    }
+};
+
+#endif // G_BYTECODE_HPP
@@ -0,0 +1,222 @@
+/**
+ * @file    G-Programming-Language/Compiler/bytecode_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * Startup of gvm from the source against startup from a precompiled
+ * .gbc file.
+ *
+ * Programs of 1k to 100k statements (the first argument changes the
+ * largest) are run from the source, as gvm prog.g does: read, lex,
+ * parse, compile to bytecode and run. They are then saved as .gbc
+ * and run as gvm prog.gbc does: map, check and run. The best of
+ * several runs is kept; the load column is the map and the checks
+ * alone. Both ways must print the same values.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "./bytecode.hpp"
+#include "./bytecode_file.hpp"
+#include "./compiler.hpp"
+#include "./vm.hpp"
+
+using namespace std::chrono;
+
+/**
+ * Deterministic generator, so every run loads the same programs
+ */
+struct Random
+{
+    uint64_t state;
+
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (uint32_t)(state >> 33) % bound;
+    }
+};
+
+/**
+ * A program of ints, floats, booleans and strings, so that every
+ * section of the .gbc file has something in it
+ *
+ * @param random     generator
+ * @param statements number of statements
+ * @return the source
+ */
+std::string generate(Random &random, int statements)
+{
+    std::stringstream ss;
+    ss << "int i0 = 7;\nfloat f1 = 1.5;\nboolean b2 = true;\nstring s3 = \"g\";\n";
+    for (int s = 4; s < statements; ++s)
+    {
+        int earlier = 4 * random.next(s / 4);
+        switch (s % 4)
+        {
+        case 0:
+            ss << "int i" << s << " = (i" << earlier << " + " << random.next(100) << ") * 3 % 1009;\n";
+            break;
+        case 1:
+            ss << "float f" << s << " = f" << earlier + 1 << " * 0.5 + " << random.next(100) << ".25;\n";
+            break;
+        case 2:
+            ss << "boolean b" << s << " = i" << earlier << " < " << random.next(1009) << " || b" << earlier + 2
+               << ";\n";
+            break;
+        default:
+            ss << "string s" << s << " = \"setting " << s << "\";\n";
+            break;
+        }
+    }
+    return ss.str();
+}
+
+/**
+ * Milliseconds a function takes, the best of some runs
+ *
+ * @param runs number of runs
+ * @param work what is measured, returns false if it failed
+ * @return the time, negative if the work failed
+ */
+template <typename Work>
+double best(int runs, Work work)
+{
+    double fastest = -1;
+    for (int r = 0; r < runs; ++r)
+    {
+        auto start = steady_clock::now();
+        if (!work())
+        {
+            return -1;
+        }
+        double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        fastest = fastest < 0 ? ms : std::min(fastest, ms);
+    }
+    return fastest;
+}
+
+/**
+ * Compiles a source file to bytecode, as gvm does
+ *
+ * @param path     of the source
+ * @param bytecode where the program is written
+ * @return false if the program is not valid
+ */
+bool build(const std::string &path, Bytecode &bytecode)
+{
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, quiet);
+    File file(path);
+    std::string source = file.read();
+    Lexer lexer(context, source);
+    std::vector<Token> tokens = lexer.lex();
+    Parser parser(context, tokens);
+    std::shared_ptr<ParseTreeNode> tree = parser.parse(1);
+    BytecodeCompiler compiler(*parser.getSymbolTable());
+    return lexer.areValid() && parser.isValid() && compiler.compile(tree, bytecode);
+}
+
+/**
+ * Runs a program
+ *
+ * @param image  of the program
+ * @param values where its final values are printed, if given
+ * @return false if it was stopped
+ */
+bool run(const BcImage &image, std::ostream *values = nullptr)
+{
+    VirtualMachine vm(image);
+    if (!vm.run())
+    {
+        return false;
+    }
+    if (values)
+    {
+        vm.printValues(*values);
+    }
+    return true;
+}
+
+/**
+ * Size of a file in KB
+ */
+double kilobytes(const std::string &path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? info.st_size / 1024.0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    int largest = argc > 1 ? std::max(1000, atoi(argv[1])) : 100000;
+    const int runs = 5;
+
+    char directory[] = "/tmp/g_bytecode_benchmark_XXXXXX";
+    if (!mkdtemp(directory))
+    {
+        std::cerr << "[!] Cannot create a temporary directory.\n";
+        return EXIT_FAILURE;
+    }
+    std::printf("%10s %10s %10s %12s %12s %10s\n", "statements", "source KB", ".gbc KB", "from .g ms", "from .gbc ms",
+                "load ms");
+    Random random = {46};
+    bool failed = false;
+    for (int statements = 1000; statements <= largest && !failed; statements *= 10)
+    {
+        std::string source = std::string(directory) + "/p" + std::to_string(statements) + ".g";
+        std::string precompiled = source + "bc";
+        std::ofstream(source) << generate(random, statements);
+
+        double fromSource = best(runs, [&]
+                                 {
+            Bytecode bytecode;
+            return build(source, bytecode) && run(bytecode.image()); });
+        Bytecode bytecode;
+        if (!build(source, bytecode) || !BytecodeFile::write(bytecode, precompiled))
+        {
+            std::cerr << "[!] " << source << " not compiled to bytecode.\n";
+            std::remove(source.c_str());
+            failed = true;
+            break;
+        }
+        double fromFile = best(runs, [&]
+                               {
+            BytecodeFile file;
+            return file.load(precompiled) && run(file.getImage()); });
+        double load = best(runs, [&]
+                           {
+            BytecodeFile file;
+            return file.load(precompiled); });
+
+        std::stringstream expected;
+        std::stringstream loaded;
+        BytecodeFile file;
+        bool same = run(bytecode.image(), &expected) && file.load(precompiled) && run(file.getImage(), &loaded) &&
+                    expected.str() == loaded.str();
+        if (!same)
+        {
+            std::cerr << "[!] " << precompiled << " does not print what " << source << " prints.\n";
+        }
+        failed = failed || !same || fromSource < 0 || fromFile < 0 || load < 0;
+        std::printf("%10d %10.1f %10.1f %12.2f %12.2f %10.2f\n", statements, kilobytes(source), kilobytes(precompiled),
+                    fromSource, fromFile, load);
+        std::remove(source.c_str());
+        std::remove(precompiled.c_str());
+    }
+    rmdir(directory);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
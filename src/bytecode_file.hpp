@@ -0,0 +1,394 @@
+/**
+ * @file    G-Programming-Language/Compiler/bytecode_file.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_BYTECODE_FILE_HPP
+#define G_BYTECODE_FILE_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "./bytecode.hpp"
+
+/**
+ * Where a section is in a file: offset in bytes from the start of
+ * the file and number of elements
+ */
+struct GbcSection
+{
+    uint32_t offset;
+    uint32_t count;
+};
+
+/**
+ * First bytes of a .gbc file. The file is little endian and every
+ * section starts at a multiple of 8 bytes, so once mapped its
+ * sections are used where they are: code words, constants (8
+ * bytes each), string table (words) and variables (BcVariable).
+ */
+struct GbcHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t headerSize;
+
+    /**
+     * ORDER_MARK as written: it reads differently on a machine
+     * of the other endianness
+     */
+    uint32_t byteOrder;
+    uint32_t registers;
+
+    /**
+     * Size of the whole file
+     */
+    uint64_t size;
+
+    /**
+     * Of the whole file with this field zero, see
+     * BytecodeFile::checksum
+     */
+    uint64_t checksum;
+
+    GbcSection code;
+    GbcSection constants;
+    GbcSection strings;
+    GbcSection variables;
+};
+
+static_assert(sizeof(GbcHeader) == 64, "the header of a .gbc file is 64 bytes");
+
+/**
+ * A precompiled program (.gbc) mapped into memory.
+ *
+ * Loading does not parse or copy anything: the file is checked
+ * (size, version, checksum, and every index of the code against
+ * the section it refers to) and its sections are then used in
+ * place. The code is still unpacked by the VirtualMachine into
+ * its slots, once, before the first run.
+ * The types of the registers are not checked, so a file is
+ * trusted like an executable; the checksum only catches files
+ * that were damaged.
+ */
+class BytecodeFile
+{
+public:
+    static const uint16_t VERSION = 1;
+    static const uint32_t ORDER_MARK = 0x01020304;
+
+    BytecodeFile() = default;
+
+    BytecodeFile(const BytecodeFile &) = delete;
+    BytecodeFile &operator=(const BytecodeFile &) = delete;
+
+    ~BytecodeFile()
+    {
+        if (mapping)
+        {
+            munmap(mapping, size);
+        }
+    }
+
+    /**
+     * Writes a program to a file
+     *
+     * @param bytecode of the program
+     * @param path     of the file
+     * @return false if the file could not be written
+     */
+    static bool write(const Bytecode &bytecode, const std::string &path)
+    {
+        GbcHeader header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        header.headerSize = sizeof(GbcHeader);
+        header.byteOrder = ORDER_MARK;
+        header.registers = bytecode.registers;
+
+        std::vector<uint64_t> words;
+        auto append = [&](GbcSection &section, const void *data, size_t count, size_t bytes)
+        {
+            section.offset = (uint32_t)(sizeof(GbcHeader) + words.size() * 8);
+            section.count = (uint32_t)count;
+            size_t start = words.size();
+            words.resize(start + (bytes + 7) / 8, 0);
+            if (bytes)
+            {
+                std::memcpy(&words[start], data, bytes);
+            }
+        };
+        append(header.code, bytecode.code.data(), bytecode.code.size(), bytecode.code.size() * 8);
+        append(header.constants, bytecode.constants.data(), bytecode.constants.size(),
+               bytecode.constants.size() * sizeof(BcValue));
+        append(header.strings, bytecode.strings.data(), bytecode.strings.size(), bytecode.strings.size() * 8);
+        append(header.variables, bytecode.variables.data(), bytecode.variables.size(),
+               bytecode.variables.size() * sizeof(BcVariable));
+        header.size = sizeof(GbcHeader) + words.size() * 8;
+        header.checksum = checksum(header, words.data(), words.size());
+
+        std::ofstream output(path, std::ios::binary);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char *>(words.data()), words.size() * 8);
+        return output.good();
+    }
+
+    /**
+     * Maps and checks a file
+     *
+     * @param path of the file
+     * @return false if it cannot be used, see getError
+     */
+    bool load(const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return fail("cannot open " + path);
+        }
+        struct stat info
+        {
+        };
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(GbcHeader))
+        {
+            close(fd);
+            return fail("not a bytecode file");
+        }
+        size = (size_t)info.st_size;
+        void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (address == MAP_FAILED)
+        {
+            return fail("cannot map " + path);
+        }
+        mapping = address;
+        return validate();
+    }
+
+    /**
+     * The program, valid as long as this file is
+     */
+    const BcImage &getImage() const
+    {
+        return image;
+    }
+
+    const std::string &getError() const
+    {
+        return error;
+    }
+
+    /**
+     * FNV-1a over 64 bit words: the sections are word aligned, and a
+     * word at a time is fast enough not to matter next to mapping
+     *
+     * @param header of the file, its checksum is taken as zero
+     * @param words  after the header
+     * @param count  number of words
+     * @return the hash
+     */
+    static uint64_t checksum(const GbcHeader &header, const uint64_t *words, size_t count)
+    {
+        uint64_t first[sizeof(GbcHeader) / 8];
+        std::memcpy(first, &header, sizeof(header));
+        first[offsetof(GbcHeader, checksum) / 8] = 0;
+        uint64_t hash = 14695981039346656037ULL;
+        for (uint64_t word : first)
+        {
+            hash = (hash ^ word) * 1099511628211ULL;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            hash = (hash ^ words[i]) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+private:
+    static constexpr const char *MAGIC = "GBC";
+
+    void *mapping = nullptr;
+
+    size_t size = 0;
+
+    BcImage image = {};
+
+    std::string error;
+
+    /**
+     * Offsets of the records of the string table, in order
+     */
+    std::vector<uint32_t> records;
+
+    bool fail(const std::string &why)
+    {
+        error = why;
+        return false;
+    }
+
+    const char *base() const
+    {
+        return static_cast<const char *>(mapping);
+    }
+
+    /**
+     * Checks that a section is aligned and inside the file
+     */
+    bool section(const GbcSection &section, size_t element, const char *name)
+    {
+        if (section.offset % 8 != 0 || section.offset < sizeof(GbcHeader) ||
+            section.offset + (uint64_t)section.count * element > size)
+        {
+            return fail(std::string("the ") + name + " section is out of the file");
+        }
+        return true;
+    }
+
+    bool validate()
+    {
+        const GbcHeader &header = *reinterpret_cast<const GbcHeader *>(base());
+        if (std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0)
+        {
+            return fail("not a bytecode file");
+        }
+        if (header.version != VERSION || header.headerSize != sizeof(GbcHeader))
+        {
+            return fail("bytecode version " + std::to_string(header.version) + ", expected " +
+                        std::to_string(VERSION));
+        }
+        if (header.byteOrder != ORDER_MARK)
+        {
+            return fail("bytecode written on a machine of another byte order");
+        }
+        if (header.size != size || size % 8 != 0)
+        {
+            return fail("truncated bytecode file");
+        }
+        const uint64_t *words = reinterpret_cast<const uint64_t *>(base() + sizeof(GbcHeader));
+        if (checksum(header, words, (size - sizeof(GbcHeader)) / 8) != header.checksum)
+        {
+            return fail("wrong checksum, the file is damaged");
+        }
+        if (!section(header.code, 8, "code") || !section(header.constants, sizeof(BcValue), "constant") ||
+            !section(header.strings, 8, "string") || !section(header.variables, sizeof(BcVariable), "variable"))
+        {
+            return false;
+        }
+        if (header.registers > BcWord::MAX_OPERAND + 1)
+        {
+            return fail("too many registers");
+        }
+
+        image.code = reinterpret_cast<const uint64_t *>(base() + header.code.offset);
+        image.codeSize = header.code.count;
+        image.constants = reinterpret_cast<const BcValue *>(base() + header.constants.offset);
+        image.constantCount = header.constants.count;
+        image.strings = reinterpret_cast<const uint64_t *>(base() + header.strings.offset);
+        image.stringWords = header.strings.count;
+        image.variables = reinterpret_cast<const BcVariable *>(base() + header.variables.offset);
+        image.variableCount = header.variables.count;
+        image.registers = header.registers;
+        return validateStrings() && validateVariables() && validateCode();
+    }
+
+    bool isString(int64_t offset) const
+    {
+        return offset >= 0 && offset <= UINT32_MAX &&
+               std::binary_search(records.begin(), records.end(), (uint32_t)offset);
+    }
+
+    bool validateStrings()
+    {
+        records.clear();
+        for (uint64_t offset = 0; offset < image.stringWords;)
+        {
+            const BcString *record = image.string((uint32_t)offset);
+            uint64_t words = BcString::words(record->size);
+            if (offset + words > image.stringWords || record->chars()[record->size] != '\0')
+            {
+                return fail("broken string at " + std::to_string(offset));
+            }
+            records.push_back((uint32_t)offset);
+            offset += words;
+        }
+        return true;
+    }
+
+    bool validateVariables()
+    {
+        for (uint32_t v = 0; v < image.variableCount; ++v)
+        {
+            const BcVariable &variable = image.variables[v];
+            if (!isString(variable.name) || variable.reg >= image.registers || variable.type == IrType::VOID ||
+                variable.type > IrType::STRING || variable.assigned > 1)
+            {
+                return fail("broken variable " + std::to_string(v));
+            }
+        }
+        return true;
+    }
+
+    bool validateCode()
+    {
+        if (image.codeSize == 0)
+        {
+            return fail("no code");
+        }
+        for (uint32_t pc = 0; pc < image.codeSize; ++pc)
+        {
+            uint64_t word = image.code[pc];
+            BcOp op = BcWord::opOf(word);
+            if (op > BcOp::RET)
+            {
+                return fail("unknown instruction at " + std::to_string(pc));
+            }
+            int operands = BcWord::registersOf(op);
+            bool valid = (operands < 1 || BcWord::aOf(word) < image.registers) &&
+                         (operands < 2 || BcWord::bOf(word) < image.registers) &&
+                         (operands < 3 || BcWord::cOf(word) < image.registers);
+            int64_t bx = BcWord::bxOf(word);
+            switch (op)
+            {
+            case BcOp::LOADK:
+                valid = valid && bx >= 0 && bx < image.constantCount;
+                break;
+            case BcOp::LOADS:
+                valid = valid && isString(bx);
+                break;
+            case BcOp::JMP:
+            case BcOp::JMPF:
+            case BcOp::JMPT:
+                valid = valid && bx >= 0 && bx < image.codeSize;
+                break;
+            default:
+                break;
+            }
+            if (!valid)
+            {
+                return fail("operand out of range at " + std::to_string(pc));
+            }
+        }
+        // the machine does not check for the end of the code
+        BcOp last = BcWord::opOf(image.code[image.codeSize - 1]);
+        if (last != BcOp::RET && last != BcOp::JMP)
+        {
+            return fail("the code does not end with ret");
+        }
+        return true;
+    }
+};
+
+#endif // G_BYTECODE_FILE_HPP
@@ -0,0 +1,176 @@
+/**
+ * @file    G-Programming-Language/Compiler/compile_stress.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * Compilations running at once in one process must not see each
+ * other.
+ *
+ * 64 generated files, some with syntax or symbol errors, are
+ * compiled one after the other, then several times on a pool of
+ * threads (8 by default, the first argument changes it), every
+ * compilation with its own CompilationContext and some with more
+ * than one parser thread. The exit code, the output and the
+ * diagnostics of every file must be the same each time.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "./compiler.hpp"
+
+/**
+ * Deterministic generator, so every run compiles the same files
+ */
+struct Random
+{
+    uint64_t state;
+
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (uint32_t)(state >> 33) % bound;
+    }
+};
+
+/**
+ * A program of a random size. One file in four also uses
+ * undeclared variables, one in eight has a syntax error.
+ *
+ * @param random generator
+ * @param file   number of the file
+ * @return the source
+ */
+std::string generate(Random &random, int file)
+{
+    std::stringstream ss;
+    std::vector<int> ints = {0};
+    ss << "int v0 = 1;\n";
+    int statements = 200 + random.next(5000);
+    for (int s = 1; s < statements; ++s)
+    {
+        uint32_t kind = random.next(10);
+        if (kind < 6)
+        {
+            ss << "int v" << s << " = " << random.next(100) << " + " << random.next(7) << " * (v"
+               << ints[random.next(ints.size())] << " - 1);\n";
+            ints.push_back(s);
+        }
+        else if (kind < 8)
+        {
+            ss << "v" << ints[random.next(ints.size())] << " = v" << ints[random.next(ints.size())] << " / 3;\n";
+        }
+        else if (kind < 9 && file % 4 == 0)
+        {
+            ss << "int w" << random.next(5) << " = x" << s << ";\n";
+        }
+        else
+        {
+            ss << "boolean b" << s << " = " << random.next(9) << " < 3 && !(1 == 2);\n";
+        }
+    }
+    if (file % 8 == 1)
+    {
+        ss << "int broken = ;\n";
+    }
+    return ss.str();
+}
+
+/**
+ * What a compilation produced
+ */
+struct Outcome
+{
+    int code;
+    std::string output;
+    std::string diagnostics;
+
+    bool operator==(const Outcome &other) const
+    {
+        return code == other.code && output == other.output && diagnostics == other.diagnostics;
+    }
+};
+
+/**
+ * Compiles a file with a context of its own
+ *
+ * @param path of the file
+ * @param jobs threads of the parser
+ * @return what the compilation produced
+ */
+Outcome compileAlone(const std::string &path, unsigned jobs)
+{
+    std::stringstream out;
+    std::stringstream err;
+    CompilationContext context(out, err);
+    CompileOptions options;
+    options.jobs = jobs;
+    int code = compile(path, options, context);
+    return {code, out.str(), err.str()};
+}
+
+int main(int argc, char *argv[])
+{
+    const unsigned threads = argc > 1 ? std::max(1, atoi(argv[1])) : 8;
+    const int files = 64;
+    const int rounds = 3;
+
+    char directory[] = "/tmp/g_compile_stress_XXXXXX";
+    if (!mkdtemp(directory))
+    {
+        std::cerr << "[!] Cannot create a temporary directory.\n";
+        return EXIT_FAILURE;
+    }
+    Random random = {42};
+    std::vector<std::string> paths;
+    for (int f = 0; f < files; ++f)
+    {
+        paths.push_back(std::string(directory) + "/f" + std::to_string(f) + ".g");
+        std::ofstream(paths.back()) << generate(random, f);
+    }
+
+    std::vector<Outcome> serial(files);
+    for (int f = 0; f < files; ++f)
+    {
+        serial[f] = compileAlone(paths[f], 1);
+    }
+
+    int mismatches = 0;
+    for (int round = 0; round < rounds; ++round)
+    {
+        std::vector<Outcome> concurrent(files);
+        parallelFor(files, threads, [&](size_t f, size_t)
+                    { concurrent[f] = compileAlone(paths[f], 1 + f % 3); });
+        for (int f = 0; f < files; ++f)
+        {
+            if (!(concurrent[f] == serial[f]))
+            {
+                ++mismatches;
+                std::cerr << "[!] Round " << round << ": " << paths[f] << " differs from the serial compilation.\n";
+            }
+        }
+    }
+
+    int failing = 0;
+    for (int f = 0; f < files; ++f)
+    {
+        failing += serial[f].code != SUCCESSFUL_COMPILATION;
+        std::remove(paths[f].c_str());
+        std::remove((paths[f].substr(0, paths[f].size() - 2) + ".cpp").c_str());
+    }
+    rmdir(directory);
+
+    std::cout << files << " files, " << rounds << " rounds on " << threads << " threads, " << failing
+              << " failing on purpose, " << mismatches << " mismatches\n";
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
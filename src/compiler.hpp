@@ -0,0 +1,509 @@
+/**
+ * @file    G-Programming-Language/Compiler/compiler.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_COMPILER_HPP
+#define G_COMPILER_HPP
+#pragma once
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./asm_generator.hpp"
+#include "./constant_folding.hpp"
+#include "./context.hpp"
+#include "./dead_stores.hpp"
+#include "./downstream.hpp"
+#include "./file.hpp"
+#include "./jit.hpp"
+#include "./lowering.hpp"
+#include "./parser_new.hpp"
+#include "./partial_evaluation.hpp"
+#include "./pass_manager.hpp"
+#include "./range_analysis.hpp"
+#include "./unity.hpp"
+
+/**
+ * Exit codes
+ */
+enum exit_codes
+{
+    SUCCESSFUL_COMPILATION,
+    MISSING_ARGUMENT,
+    FILE_DOESNT_EXIST,
+    SOURCE_CODE_IS_EMPTY,
+    NO_TOKENS_FOUND,
+    INVALID_TOKENS,
+    INVALID_SYNTAX,
+    CODE_NOT_GENERATED,
+    CODE_NOT_ASSEMBLED,
+    PROGRAM_STOPPED,
+    CODE_NOT_COMPILED
+};
+
+/**
+ * How to compile, set from the command line
+ */
+struct CompileOptions
+{
+    /**
+     * Maximum number of threads for parsing, and of C++
+     * compilations at once with 'build'
+     */
+    unsigned jobs = 1;
+
+    /**
+     * Optimisation level, 0 to 2
+     */
+    int level = 2;
+
+    /**
+     * Passes not to run
+     */
+    std::vector<std::string> disabled;
+
+    /**
+     * Passes after which the program is printed
+     */
+    std::vector<std::string> printAfter;
+
+    /**
+     * Print the time of every pass to stderr, and write it as
+     * JSON to <name>.passes.json
+     */
+    bool timePasses = false;
+
+    /**
+     * Print the range and the C++ type of every int
+     */
+    bool reportRanges = false;
+
+    /**
+     * The final values of the variables are observable: run the
+     * program at compile time and emit only its final values
+     * when they are all constants
+     */
+    bool evaluate = false;
+
+    /**
+     * What the program is translated to
+     */
+    enum class Backend
+    {
+        /**
+         * C++ source, <name>.cpp
+         */
+        CPP,
+        /**
+         * x86-64 assembly, <name>.s, assembled and linked with
+         * 'as' and 'ld' into the executable <name>
+         */
+        ASM
+    };
+
+    Backend backend = Backend::CPP;
+
+    /**
+     * Headers the C++ backend includes
+     */
+    HeaderMode headers = HeaderMode::IOSTREAM;
+
+    /**
+     * Run the program inside the compiler, translated to machine
+     * code in memory, and print the final values of its variables
+     */
+    bool run = false;
+
+    /**
+     * Compile the C++ of every file with the host compiler into an
+     * executable, reusing the objects of code compiled before
+     */
+    bool build = false;
+
+    /**
+     * Compiler, flags and cache of the build, its jobs are 'jobs'
+     */
+    DownstreamOptions downstream;
+
+    /**
+     * Number of translation units all the files are generated
+     * into, see UnityBuild; 0 for a .cpp file per source file
+     */
+    size_t shards = 0;
+};
+
+/**
+ * Adds the passes of an optimisation level:
+ * -O0 none, -O1 constant folding and range analysis, -O2 also
+ * dead store elimination. From -O1 on the program is lowered
+ * to SSA form and verified. Evaluation needs constant folding,
+ * which is then added at -O0 too, as is lowering for the
+ * backends that start from SSA form.
+ *
+ * @param passes  manager to add the passes to
+ * @param options of the compilation
+ */
+inline void addPasses(PassManager &passes, const CompileOptions &options)
+{
+    int level = options.level;
+    if (level >= 1 || options.evaluate)
+    {
+        passes.add("fold", [](Module &module, CompilationContext &context)
+                   {
+            ConstantFolder folder(context, *module.symbols);
+            module.symbols = folder.run(module.tree);
+            context.getOutput() << "[i] Constants folded: " << folder.getFolded() << " operations, "
+                                << folder.getPropagated() << " variable reads.\n"; });
+    }
+    if (options.evaluate)
+    {
+        passes.add("evaluate", [](Module &module, CompilationContext &context)
+                   {
+            Evaluation evaluation = evaluateProgram(module.tree);
+            if (evaluation.evaluated)
+            {
+                context.getOutput() << "[i] Program evaluated: " << evaluation.statements << " statements, "
+                                    << evaluation.residual << " left.\n";
+            }
+            else
+            {
+                context.getOutput() << "[i] Program not evaluated: the value stored in '" << evaluation.variable
+                                    << "' at line " << evaluation.line << " is not a constant.\n";
+            } });
+    }
+    if (level >= 2)
+    {
+        // evaluated and run programs show the final values
+        bool observed = options.evaluate || options.run;
+        passes.add("dse", [observed](Module &module, CompilationContext &context)
+                   {
+            std::vector<std::string> observable;
+            if (observed)
+            {
+                for (const FrozenSymbol &symbol : module.symbols->getSymbols())
+                {
+                    observable.push_back(symbol.name);
+                }
+            }
+            DeadStores dead = eliminateDeadStores(module.tree, observable);
+            context.getOutput() << "[i] Dead stores removed: " << dead.statements << " statements, "
+                                << dead.initialisers << " initialisers.\n"; });
+    }
+    if (level >= 1)
+    {
+        bool report = options.reportRanges;
+        passes.add("ranges", [report](Module &module, CompilationContext &context)
+                   {
+            RangeAnalysis ranges(context, *module.symbols);
+            module.symbols = ranges.run(module.tree);
+            context.getOutput() << "[i] Integer widths: " << ranges.count(8) << " int8_t, "
+                                << ranges.count(16) << " int16_t, " << ranges.count(0) << " int.\n";
+            if (report)
+            {
+                ranges.report(context.getOutput());
+            } });
+    }
+    if (level >= 1 || options.run || options.backend == CompileOptions::Backend::ASM)
+    {
+        passes.add("lower", [](Module &module, CompilationContext &)
+                   { module.ir.reset(new IrProgram(lower(module.tree, *module.symbols))); });
+    }
+    if (level >= 1)
+    {
+        passes.add("verify", [](Module &module, CompilationContext &context)
+                   {
+            if (!module.ir)
+            {
+                context.warning("IR not verified: the 'lower' pass is disabled.");
+                return;
+            }
+            for (const std::string &msg : module.ir->verify())
+            {
+                context.warning("IR: " + msg);
+            } });
+    }
+}
+
+/**
+ * Translates a program to assembly and builds the executable
+ *
+ * @param file    source file, the outputs are written next to it
+ * @param module  compiled program, lowered here if it is not yet
+ * @param context of this compilation
+ * @return exit code
+ */
+inline int assemble(File &file, Module &module, CompilationContext &context)
+{
+    std::ostream &out = context.getOutput();
+    std::ostream &err = context.getErrorOutput();
+    if (!module.ir)
+    {
+        module.ir.reset(new IrProgram(lower(module.tree, *module.symbols)));
+    }
+    AsmGenerator generator(*module.ir);
+    std::string unsupported = generator.unsupported();
+    if (!unsupported.empty())
+    {
+        err << "[!] The assembly backend does not support " << unsupported << ". Code not generated.\n";
+        return CODE_NOT_GENERATED;
+    }
+    std::string code = generator.generate();
+    file.write(code, ".s");
+    out << code << "\n";
+    out << "[i] Registers: " << generator.getSpilled() << " values spilled, "
+        << generator.getFrameSize() << " bytes of stack.\n";
+
+    std::string base = file.getPath() + file.getFileName();
+    std::string command = "as -o " + shellQuote(base + ".o") + " " + shellQuote(base + ".s") + " && ld -o " +
+                          shellQuote(base) + " " + shellQuote(base + ".o");
+    if (std::system(command.c_str()) != 0)
+    {
+        err << "[!] Assembling or linking failed: " << command << "\n";
+        return CODE_NOT_ASSEMBLED;
+    }
+    out << "[i] Executable written: " << base << "\n";
+    return SUCCESSFUL_COMPILATION;
+}
+
+/**
+ * Translates a program to machine code in memory, runs it and
+ * prints the final values of its variables. Both steps are
+ * measured as passes, "jit" and "run".
+ *
+ * @param passes  manager measuring the steps
+ * @param module  compiled program, lowered here if it is not yet
+ * @param context of this compilation
+ * @return exit code
+ */
+inline int runProgram(PassManager &passes, Module &module, CompilationContext &context)
+{
+    std::ostream &err = context.getErrorOutput();
+    if (!module.ir)
+    {
+        module.ir.reset(new IrProgram(lower(module.tree, *module.symbols)));
+    }
+    std::string unsupported = AsmGenerator(*module.ir).unsupported();
+    if (!unsupported.empty())
+    {
+        err << "[!] The JIT does not support " << unsupported << ". Program not run.\n";
+        return CODE_NOT_GENERATED;
+    }
+    JitProgram jit;
+    bool loaded = false;
+    passes.measure("jit", module, [&jit, &loaded](Module &module, CompilationContext &)
+                   { loaded = jit.load(AsmGenerator(*module.ir).generate(false)); });
+    if (!loaded)
+    {
+        err << "[!] Machine code not generated: " << jit.getError() << "\n";
+        return CODE_NOT_GENERATED;
+    }
+    bool completed = false;
+    passes.measure("run", module, [&jit, &completed](Module &, CompilationContext &)
+                   { completed = jit.run(); });
+    if (!completed)
+    {
+        err << "[!] The program was stopped by a division by zero or an overflowing division.\n";
+        return PROGRAM_STOPPED;
+    }
+    printValues(jit, *module.ir, context.getOutput());
+    return SUCCESSFUL_COMPILATION;
+}
+
+/**
+ * Compiles a file to C++, or to an executable with the assembly
+ * backend. Everything the compilation prints goes to the streams
+ * of its context and no global state is touched, so it can run
+ * on several threads at once.
+ *
+ * @param path    of the source file
+ * @param options of the compilation
+ * @param context of this compilation
+ * @param unity   where the C++ goes instead of <name>.cpp, if any
+ * @return exit code
+ */
+inline int compile(const std::string &path, const CompileOptions &options, CompilationContext &context,
+                   UnityBuild *unity = nullptr)
+{
+    std::ostream &out = context.getOutput();
+    std::ostream &err = context.getErrorOutput();
+
+    out << "[0] Checking if file exists...\n";
+    File file(path);
+    if (!file.exists())
+    {
+        err << "[!] File does not exist.\n";
+        return FILE_DOESNT_EXIST;
+    }
+    out << "[1] File found.\n";
+
+    out << "[2] Reading source code...\n";
+    std::string sourcecode = file.read();
+    if (sourcecode.empty())
+    {
+        err << "[!] File is empty.\n";
+        return SOURCE_CODE_IS_EMPTY;
+    }
+    out << "[3] Source code read.\n";
+
+    out << "[4] Analysing tokens...\n";
+    Lexer lexer(context, sourcecode);
+    std::vector<Token> tokens = lexer.lex();
+    if (tokens.empty())
+    {
+        err << "[!] Error while analyzing tokens. No tokens were found.\n";
+        return NO_TOKENS_FOUND;
+    }
+
+    if (!lexer.areValid())
+    {
+        err << "[!] Error while analyzing tokens. There are invalid tokens.\n";
+        return INVALID_TOKENS;
+    }
+    out << "[5] Tokens analysed successfully.\n";
+
+    out << "[6] Analysing syntax...\n";
+    Parser parser(context, tokens);
+    std::shared_ptr<ParseTreeNode> parseTree = parser.parse(options.jobs);
+    if (!parser.isValid())
+    {
+        return INVALID_SYNTAX;
+    }
+
+    PassManager passes(context);
+    addPasses(passes, options);
+    for (const std::string &name : options.disabled)
+    {
+        if (!passes.disable(name))
+        {
+            context.warning("Unknown pass '" + name + "' at -O" + std::to_string(options.level) + ".");
+        }
+    }
+    for (const std::string &name : options.printAfter)
+    {
+        if (!passes.printAfter(name))
+        {
+            context.warning("Unknown pass '" + name + "' at -O" + std::to_string(options.level) + ".");
+        }
+    }
+    Module module = {parseTree, parser.getSymbolTable(), nullptr};
+    passes.run(module);
+    int result = SUCCESSFUL_COMPILATION;
+    if (options.run)
+    {
+        out << "[8] Running...\n";
+        result = runProgram(passes, module, context);
+    }
+    if (module.ir)
+    {
+        out << "[i] IR: " << module.ir->getInstructions().size() << " instructions in "
+            << module.ir->getBlocks().size() << " blocks.\n";
+    }
+    if (options.timePasses)
+    {
+        passes.report(std::cerr);
+        std::ofstream json(file.getPath() + file.getFileName() + ".passes.json");
+        passes.writeJson(json);
+    }
+    if (options.run)
+    {
+        return result;
+    }
+
+    FlatAst ast = flatten(parseTree);
+    ast.print(out);
+    out << "[7] Correct syntax. Abstract Syntax Tree built correctly.\n";
+
+    out << "[8] Generating code...\n";
+    if (options.backend == CompileOptions::Backend::ASM)
+    {
+        int code = assemble(file, module, context);
+        if (code != SUCCESSFUL_COMPILATION)
+        {
+            return code;
+        }
+        out << "[9] Code generated!\n";
+        out << "[#] Compilation terminated successfully.\n";
+        return SUCCESSFUL_COMPILATION;
+    }
+    CodeGenerator cg(module.symbols, options.headers);
+    CodeBuffer body = cg.generateBody(parseTree);
+    std::string includes = cg.includes(body);
+    std::string code = unity ? std::move(body.text) : includes + body.text;
+    if (code == "")
+    {
+        err << "[!] Unknown error. Code not generated.\n";
+        return CODE_NOT_GENERATED;
+    }
+    if (unity)
+    {
+        unity->add(file.getFileName(), includes, code);
+    }
+    else
+    {
+        file.write(code);
+    }
+    out << code << "\n";
+    out << "[9] Code generated!\n";
+    out << "[#] Compilation terminated successfully.\n";
+    return SUCCESSFUL_COMPILATION;
+}
+
+/**
+ * Compiles files one after the other, stopping at the first that
+ * fails, then with options.build compiles their C++ in parallel.
+ * With options.shards the C++ of all the files goes to units
+ * <path>unity_<k>.cpp, next to the first file, built into the
+ * executable <path>unity.
+ *
+ * @param paths   of the source files
+ * @param options of the compilation
+ * @param context of this compilation
+ * @return exit code
+ */
+inline int compileFiles(const std::vector<std::string> &paths, const CompileOptions &options,
+                        CompilationContext &context)
+{
+    std::ostream &out = context.getOutput();
+    UnityBuild unity;
+    std::vector<DownstreamTarget> targets;
+    for (const std::string &path : paths)
+    {
+        int code = compile(path, options, context, options.shards ? &unity : nullptr);
+        if (code != SUCCESSFUL_COMPILATION)
+        {
+            return code;
+        }
+        File file(path);
+        std::string base = file.getPath() + file.getFileName();
+        targets.push_back({base, {base + ".cpp"}});
+    }
+    if (options.shards)
+    {
+        std::string base = File(paths[0]).getPath() + "unity";
+        targets = {{base, unity.write(base, options.shards)}};
+        out << "[i] Unity build: " << unity.size() << " programs in " << targets[0].sources.size()
+            << " translation units.\n";
+    }
+    if (!options.build)
+    {
+        return SUCCESSFUL_COMPILATION;
+    }
+
+    out << "[10] Compiling C++...\n";
+    DownstreamOptions downstream = options.downstream;
+    downstream.jobs = options.jobs;
+    DownstreamResult result = buildExecutables(targets, downstream, out, context.getErrorOutput());
+    out << "[i] C++ compiled: " << result.built << " files, " << result.cached << " from the cache, "
+        << result.failed << " failed.\n";
+    return result.failed ? CODE_NOT_COMPILED : SUCCESSFUL_COMPILATION;
+}
+
+#endif // G_COMPILER_HPP
@@ -0,0 +1,742 @@
+/**
+ * @file    G-Programming-Language/Compiler/constant_folding.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_CONSTANT_FOLDING_HPP
+#define G_CONSTANT_FOLDING_HPP
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./context.hpp"
+#include "./interner.hpp"
+#include "./parser_new.hpp"
+#include "./symbols.hpp"
+
+/**
+ * Constant folding and propagation on the parse tree.
+ *
+ * Statements run in order and the value of every variable is
+ * tracked, so reads of constant variables are replaced by their
+ * value and operations on constants by their result. Values
+ * follow the C++ the program is translated to: int arithmetic
+ * wraps nowhere (an overflow is reported and left to run time),
+ * float and double are rounded separately, and a division by
+ * zero is reported and never folded.
+ *
+ * The final values go into a new frozen symbol table.
+ */
+class ConstantFolder
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param context of the compilation, receives the diagnostics
+     * @param symbols of the parsed program
+     */
+    ConstantFolder(CompilationContext &context, const FrozenSymbolTable &symbols)
+        : context(context), symbols(symbols), strings(symbols.getStrings()) {}
+
+    /**
+     * Folds a program in place
+     *
+     * @param program root of a valid parse tree
+     * @return the symbol table with the folded final values
+     */
+    std::shared_ptr<const FrozenSymbolTable> run(const std::shared_ptr<ParseTreeNode> &program)
+    {
+        auto root = std::static_pointer_cast<NonTerminalNode>(program);
+        for (const auto &child : root->getChildren())
+        {
+            auto statement = std::static_pointer_cast<NonTerminalNode>(child);
+            auto node = std::static_pointer_cast<NonTerminalNode>(statement->getChildren().at(0));
+            if (node->getLabel() == "declaration")
+            {
+                node = std::static_pointer_cast<NonTerminalNode>(node->getChildren().at(0));
+                std::string name = node->getValue(1);
+                SymbolType type = symbols.typeOf(name);
+                // reading an uninitialised variable is never constant
+                setValue(name, node->getChildren().size() == 3 ? store(node, 2, type) : ConstValue::nonConstant());
+            }
+            else
+            {
+                std::string name = node->getValue(0);
+                setValue(name, store(node, 1, symbols.typeOf(name)));
+            }
+        }
+
+        std::vector<FrozenSymbol> folded = symbols.getSymbols();
+        for (FrozenSymbol &symbol : folded)
+        {
+            uint32_t id = names.find(symbol.name);
+            if (id != StringInterner::NO_ID)
+            {
+                symbol.value = values[id];
+            }
+        }
+        return std::make_shared<const FrozenSymbolTable>(std::move(folded), strings);
+    }
+
+    /**
+     * Number of operations replaced by their result
+     */
+    size_t getFolded() const
+    {
+        return folded;
+    }
+
+    /**
+     * Number of variable reads replaced by their value
+     */
+    size_t getPropagated() const
+    {
+        return propagated;
+    }
+
+private:
+    /**
+     * C++ type of an expression
+     */
+    enum class CType : uint8_t
+    {
+        BOOL,
+        CHAR,
+        INT,
+        FLOAT,
+        DOUBLE,
+        STRING,
+        /**
+         * Anything folding does not model, e.g. NULL in an expression
+         */
+        OTHER
+    };
+
+    struct Value
+    {
+        CType type;
+        ConstValue value;
+    };
+
+    struct Folded
+    {
+        std::shared_ptr<ParseTreeNode> node;
+        Value value;
+    };
+
+    CompilationContext &context;
+
+    const FrozenSymbolTable &symbols;
+
+    /**
+     * String constants of the symbols, plus the ones found here
+     */
+    StringInterner strings;
+
+    /**
+     * Variables assigned so far, and their current value by id
+     */
+    StringInterner names;
+    std::vector<ConstValue> values;
+
+    size_t folded = 0;
+
+    size_t propagated = 0;
+
+    void setValue(const std::string &name, ConstValue value)
+    {
+        uint32_t id = names.intern(name);
+        if (id >= values.size())
+        {
+            values.resize(id + 1);
+        }
+        values[id] = value;
+    }
+
+    /**
+     * Folds the expression stored by a statement
+     *
+     * @param node  declaration or assignment
+     * @param index of the expression among the children of 'node'
+     * @param type  of the variable written
+     * @return value stored in the variable
+     */
+    ConstValue store(const std::shared_ptr<NonTerminalNode> &node, size_t index, SymbolType type)
+    {
+        auto expression = std::static_pointer_cast<NonTerminalNode>(node->getChildren().at(index));
+        auto root = expression->getChildren().at(0);
+        auto terminal = std::dynamic_pointer_cast<TerminalNode>(root);
+        if (terminal && terminal->getType() == TokenType::NULL_KEYWORD)
+        {
+            return zeroOf(type);
+        }
+
+        Folded result = fold(root);
+        if (result.value.type == CType::STRING && result.value.value.isConstant() && terminal &&
+            terminal->getType() == TokenType::IDENTIFIER)
+        {
+            // a string literal is a 'const char*': only a whole expression can be replaced
+            result.node = std::make_shared<TerminalNode>(Token{TokenType::STRING_LITERAL, strings.getString(result.value.value.string), 0});
+            ++propagated;
+        }
+        if (result.node != root)
+        {
+            expression->replaceChildren(0, 1, {result.node});
+        }
+        return convert(result.value, type);
+    }
+
+    Folded fold(const std::shared_ptr<ParseTreeNode> &node)
+    {
+        if (auto terminal = std::dynamic_pointer_cast<TerminalNode>(node))
+        {
+            Value value = valueOf(*terminal);
+            if (terminal->getType() == TokenType::IDENTIFIER && value.value.isConstant())
+            {
+                if (auto literal = literalNode(value, 0))
+                {
+                    ++propagated;
+                    return {literal, value};
+                }
+            }
+            return {node, value};
+        }
+
+        if (auto unary = std::dynamic_pointer_cast<UnaryNode>(node))
+        {
+            Folded operand = fold(unary->getOperand());
+            Value value = unaryValue(unary->getOperator(), operand.value, unary->getLine());
+            if (isNegatedLiteral(*unary))
+            {
+                return {node, value};
+            }
+            if (value.value.isConstant())
+            {
+                if (auto literal = literalNode(value, unary->getLine()))
+                {
+                    ++folded;
+                    return {literal, value};
+                }
+            }
+            if (operand.node != unary->getOperand())
+            {
+                Token op = {unary->getOperator(), convertToken(unary->getOperator()), unary->getLine()};
+                return {std::make_shared<UnaryNode>(op, operand.node), value};
+            }
+            return {node, value};
+        }
+
+        if (auto binary = std::dynamic_pointer_cast<BinaryNode>(node))
+        {
+            Folded lhs = fold(binary->getLhs());
+            Folded rhs = fold(binary->getRhs());
+            Value value = binaryValue(binary->getOperator(), lhs.value, rhs.value, binary->getLine());
+            if (isDivisionByZero(binary->getOperator(), rhs.value))
+            {
+                // left as written, so it still traps where it did
+                return {node, value};
+            }
+            if (value.value.isConstant())
+            {
+                if (auto literal = literalNode(value, binary->getLine()))
+                {
+                    ++folded;
+                    return {literal, value};
+                }
+            }
+            if (lhs.node != binary->getLhs() || rhs.node != binary->getRhs())
+            {
+                Token op = {binary->getOperator(), convertToken(binary->getOperator()), binary->getLine()};
+                return {std::make_shared<BinaryNode>(op, lhs.node, rhs.node), value};
+            }
+            return {node, value};
+        }
+
+        return {node, {CType::OTHER, ConstValue::nonConstant()}};
+    }
+
+    static bool isDivisionByZero(TokenType op, const Value &rhs)
+    {
+        return (op == TokenType::DIVIDE || op == TokenType::MODULO) && rhs.value.isConstant() && !truth(rhs.value);
+    }
+
+    /**
+     * Checks if an operation is the way a negative number is
+     * written, which is already as folded as it gets
+     */
+    static bool isNegatedLiteral(const UnaryNode &unary)
+    {
+        auto terminal = std::dynamic_pointer_cast<TerminalNode>(unary.getOperand());
+        return unary.getOperator() == TokenType::MINUS && terminal &&
+               (terminal->getType() == TokenType::INT_LITERAL || terminal->getType() == TokenType::FLOAT_LITERAL);
+    }
+
+    /**
+     * Value of a literal or of a variable
+     */
+    Value valueOf(TerminalNode &terminal)
+    {
+        const std::string value = terminal.getValue();
+        switch (terminal.getType())
+        {
+        case TokenType::TRUE:
+            return {CType::BOOL, ConstValue::ofInt(1)};
+        case TokenType::FALSE:
+            return {CType::BOOL, ConstValue::ofInt(0)};
+        case TokenType::INT_LITERAL:
+        {
+            // a literal too big for an int is a long, which is not modelled
+            ConstValue v = intValue(value);
+            if (v.isConstant() && v.integer > INT32_MAX)
+            {
+                v = ConstValue::nonConstant();
+            }
+            return {CType::INT, v};
+        }
+        case TokenType::FLOAT_LITERAL:
+            return {CType::DOUBLE, ConstValue::ofFloat(std::strtod(value.c_str(), nullptr))};
+        case TokenType::CHAR_LITERAL:
+            return {CType::CHAR, charValue(value)};
+        case TokenType::STRING_LITERAL:
+            return {CType::STRING, ConstValue::ofString(strings.intern(value))};
+        case TokenType::IDENTIFIER:
+        {
+            CType type = ctypeOf(symbols.typeOf(value));
+            uint32_t id = names.find(value);
+            if (id == StringInterner::NO_ID)
+            {
+                return {type, ConstValue::nonConstant()};
+            }
+            return {type, values[id]};
+        }
+        default:
+            return {CType::OTHER, ConstValue::nonConstant()};
+        }
+    }
+
+    Value unaryValue(TokenType op, const Value &operand, size_t line)
+    {
+        if (operand.type == CType::STRING || operand.type == CType::OTHER)
+        {
+            return {CType::OTHER, ConstValue::nonConstant()};
+        }
+        if (op == TokenType::NOT_LOGIC)
+        {
+            if (!operand.value.isConstant())
+            {
+                return {CType::BOOL, ConstValue::nonConstant()};
+            }
+            return {CType::BOOL, ConstValue::ofInt(!truth(operand.value))};
+        }
+
+        CType type = promote(operand.type);
+        if (!operand.value.isConstant())
+        {
+            return {type, ConstValue::nonConstant()};
+        }
+        if (type == CType::INT)
+        {
+            if (operand.value.integer == INT32_MIN)
+            {
+                overflow(line);
+                return {type, ConstValue::nonConstant()};
+            }
+            return {type, ConstValue::ofInt(-operand.value.integer)};
+        }
+        return {type, real(type, -operand.value.real)};
+    }
+
+    Value binaryValue(TokenType op, const Value &lhs, const Value &rhs, size_t line)
+    {
+        if (lhs.type == CType::STRING || lhs.type == CType::OTHER ||
+            rhs.type == CType::STRING || rhs.type == CType::OTHER)
+        {
+            return {CType::OTHER, ConstValue::nonConstant()};
+        }
+
+        if (op == TokenType::AND_CONDITIONAL || op == TokenType::OR_CONDITIONAL)
+        {
+            bool isAnd = op == TokenType::AND_CONDITIONAL;
+            // the right operand is not evaluated, and has no side effects anyway
+            if (lhs.value.isConstant() && truth(lhs.value) != isAnd)
+            {
+                return {CType::BOOL, ConstValue::ofInt(!isAnd)};
+            }
+            if (!lhs.value.isConstant() || !rhs.value.isConstant())
+            {
+                return {CType::BOOL, ConstValue::nonConstant()};
+            }
+            return {CType::BOOL, ConstValue::ofInt(truth(rhs.value))};
+        }
+
+        CType type = common(lhs.type, rhs.type);
+        bool comparison = op == TokenType::EQUAL || op == TokenType::NOT_EQUAL ||
+                          op == TokenType::LOWER || op == TokenType::LOWER_EQUAL ||
+                          op == TokenType::GREATER || op == TokenType::GREATER_EQUAL;
+        CType result = comparison ? CType::BOOL : type;
+        bool integral = op == TokenType::MODULO || op == TokenType::AND_LOGIC ||
+                        op == TokenType::OR_LOGIC || op == TokenType::XOR_LOGIC;
+        if (integral && type != CType::INT)
+        {
+            // not valid C++ on floating point operands
+            return {CType::OTHER, ConstValue::nonConstant()};
+        }
+
+        if (isDivisionByZero(op, rhs))
+        {
+            std::stringstream ss;
+            ss << "Division by zero at line " << line << ", the expression is not folded.";
+            context.warning(ss.str());
+            return {result, ConstValue::nonConstant()};
+        }
+        if (!lhs.value.isConstant() || !rhs.value.isConstant())
+        {
+            return {result, ConstValue::nonConstant()};
+        }
+
+        if (type == CType::INT)
+        {
+            // both operands are ints, so every result fits in 64 bits
+            int64_t a = lhs.value.integer;
+            int64_t b = rhs.value.integer;
+            int64_t r = 0;
+            switch (op)
+            {
+            case TokenType::PLUS:
+                r = a + b;
+                break;
+            case TokenType::MINUS:
+                r = a - b;
+                break;
+            case TokenType::MULTIPLY:
+                r = a * b;
+                break;
+            case TokenType::DIVIDE:
+                r = a / b;
+                break;
+            case TokenType::MODULO:
+                // INT_MIN % -1 is undefined like INT_MIN / -1
+                if (a / b > INT32_MAX)
+                {
+                    overflow(line);
+                    return {result, ConstValue::nonConstant()};
+                }
+                r = a % b;
+                break;
+            case TokenType::AND_LOGIC:
+                r = a & b;
+                break;
+            case TokenType::OR_LOGIC:
+                r = a | b;
+                break;
+            case TokenType::XOR_LOGIC:
+                r = a ^ b;
+                break;
+            default:
+                return {result, ConstValue::ofInt(compare(op, a, b))};
+            }
+            if (r < INT32_MIN || r > INT32_MAX)
+            {
+                overflow(line);
+                return {result, ConstValue::nonConstant()};
+            }
+            return {result, ConstValue::ofInt(r)};
+        }
+
+        double a = toReal(type, lhs.value);
+        double b = toReal(type, rhs.value);
+        switch (op)
+        {
+        case TokenType::PLUS:
+            return {result, real(type, a + b)};
+        case TokenType::MINUS:
+            return {result, real(type, a - b)};
+        case TokenType::MULTIPLY:
+            return {result, real(type, a * b)};
+        case TokenType::DIVIDE:
+            return {result, real(type, a / b)};
+        default:
+            return {result, ConstValue::ofInt(compare(op, a, b))};
+        }
+    }
+
+    /**
+     * Value of an operation done in float or in double. For float
+     * the operands are already floats, and a float operation gives
+     * the double operation rounded to float.
+     */
+    static ConstValue real(CType type, double value)
+    {
+        return ConstValue::ofFloat(type == CType::FLOAT ? (double)(float)value : value);
+    }
+
+    /**
+     * Operand converted to a floating point type
+     */
+    static double toReal(CType type, const ConstValue &value)
+    {
+        double real = value.kind == ConstValue::INT ? (double)value.integer : value.real;
+        return type == CType::FLOAT ? (double)(float)real : real;
+    }
+
+    template <typename T>
+    static bool compare(TokenType op, T a, T b)
+    {
+        switch (op)
+        {
+        case TokenType::EQUAL:
+            return a == b;
+        case TokenType::NOT_EQUAL:
+            return a != b;
+        case TokenType::LOWER:
+            return a < b;
+        case TokenType::LOWER_EQUAL:
+            return a <= b;
+        case TokenType::GREATER:
+            return a > b;
+        default:
+            return a >= b;
+        }
+    }
+
+    static bool truth(const ConstValue &value)
+    {
+        return value.kind == ConstValue::INT ? value.integer != 0 : value.real != 0;
+    }
+
+    /**
+     * Integral promotion: bool and char operands become int
+     */
+    static CType promote(CType type)
+    {
+        return type == CType::BOOL || type == CType::CHAR ? CType::INT : type;
+    }
+
+    /**
+     * Usual arithmetic conversions of two promoted operands
+     */
+    static CType common(CType a, CType b)
+    {
+        if (a == CType::DOUBLE || b == CType::DOUBLE)
+        {
+            return CType::DOUBLE;
+        }
+        if (a == CType::FLOAT || b == CType::FLOAT)
+        {
+            return CType::FLOAT;
+        }
+        return CType::INT;
+    }
+
+    static CType ctypeOf(SymbolType type)
+    {
+        switch (type)
+        {
+        case SymbolType::BOOLEAN:
+            return CType::BOOL;
+        case SymbolType::INT:
+            return CType::INT;
+        case SymbolType::FLOAT:
+            return CType::FLOAT;
+        case SymbolType::CHAR:
+            return CType::CHAR;
+        case SymbolType::STRING:
+            return CType::STRING;
+        default:
+            return CType::OTHER;
+        }
+    }
+
+    /**
+     * Value stored in a variable, converted as C++ does
+     *
+     * @param value of the expression
+     * @param type  of the variable
+     * @return the value, NON_CONSTANT if the conversion is undefined
+     */
+    static ConstValue convert(const Value &value, SymbolType type)
+    {
+        const ConstValue &v = value.value;
+        if (!v.isConstant() || value.type == CType::OTHER)
+        {
+            return ConstValue::nonConstant();
+        }
+        if ((type == SymbolType::STRING) != (value.type == CType::STRING))
+        {
+            return ConstValue::nonConstant();
+        }
+
+        switch (type)
+        {
+        case SymbolType::STRING:
+            return v;
+        case SymbolType::BOOLEAN:
+            return ConstValue::ofInt(truth(v));
+        case SymbolType::INT:
+            if (v.kind == ConstValue::INT)
+            {
+                return v;
+            }
+            // the truncated value must fit
+            if (v.real > -2147483649.0 && v.real < 2147483648.0)
+            {
+                return ConstValue::ofInt((int64_t)v.real);
+            }
+            return ConstValue::nonConstant();
+        case SymbolType::CHAR:
+            if (v.kind == ConstValue::INT)
+            {
+                return ConstValue::ofInt((signed char)v.integer);
+            }
+            if (v.real > -129.0 && v.real < 128.0)
+            {
+                return ConstValue::ofInt((int64_t)v.real);
+            }
+            return ConstValue::nonConstant();
+        case SymbolType::FLOAT:
+        {
+            if (v.kind == ConstValue::INT)
+            {
+                return ConstValue::ofFloat((float)v.integer);
+            }
+            float f = (float)v.real;
+            if (std::isfinite(v.real) && !std::isfinite(f))
+            {
+                return ConstValue::nonConstant();
+            }
+            return ConstValue::ofFloat(f);
+        }
+        default:
+            return ConstValue::nonConstant();
+        }
+    }
+
+    ConstValue zeroOf(SymbolType type)
+    {
+        switch (type)
+        {
+        case SymbolType::STRING:
+            return ConstValue::ofString(strings.intern(""));
+        case SymbolType::FLOAT:
+            return ConstValue::ofFloat(0);
+        case SymbolType::UNDEFINED:
+            return ConstValue::nonConstant();
+        default:
+            return ConstValue::ofInt(0);
+        }
+    }
+
+    /**
+     * Literal with a value, of the same C++ type
+     *
+     * @param value constant
+     * @param line  of the literal
+     * @return the literal, a negated literal if the value is
+     *         negative; nullptr if it cannot be written
+     */
+    static std::shared_ptr<ParseTreeNode> literalNode(const Value &value, size_t line)
+    {
+        bool negative = false;
+        Token literal = {TokenType::UNDEFINED, "", line};
+        switch (value.type)
+        {
+        case CType::BOOL:
+            literal.type = value.value.integer ? TokenType::TRUE : TokenType::FALSE;
+            literal.value = convertToken(literal.type);
+            break;
+        case CType::CHAR:
+            literal.type = TokenType::CHAR_LITERAL;
+            literal.value = charText((char)value.value.integer);
+            break;
+        case CType::INT:
+            // -2147483648 is a long in C++
+            if (value.value.integer == INT32_MIN)
+            {
+                return nullptr;
+            }
+            negative = value.value.integer < 0;
+            literal.type = TokenType::INT_LITERAL;
+            literal.value = std::to_string(negative ? -value.value.integer : value.value.integer);
+            break;
+        case CType::FLOAT:
+        case CType::DOUBLE:
+        {
+            double real = value.value.real;
+            if (!std::isfinite(real))
+            {
+                return nullptr;
+            }
+            negative = std::signbit(real);
+            // enough digits to read back the same value
+            char text[32];
+            std::snprintf(text, sizeof(text), value.type == CType::FLOAT ? "%.9g" : "%.17g", std::fabs(real));
+            literal.type = TokenType::FLOAT_LITERAL;
+            literal.value = text;
+            if (literal.value.find_first_of(".e") == std::string::npos)
+            {
+                literal.value += ".0";
+            }
+            if (value.type == CType::FLOAT)
+            {
+                literal.value += "f";
+            }
+            break;
+        }
+        default:
+            return nullptr;
+        }
+
+        std::shared_ptr<ParseTreeNode> node = std::make_shared<TerminalNode>(literal);
+        if (negative)
+        {
+            node = std::make_shared<UnaryNode>(Token{TokenType::MINUS, "-", line}, node);
+        }
+        return node;
+    }
+
+    /**
+     * Text of a char literal, without quotes
+     */
+    static std::string charText(char c)
+    {
+        switch (c)
+        {
+        case '\n':
+            return "\\n";
+        case '\t':
+            return "\\t";
+        case '\r':
+            return "\\r";
+        case '\\':
+            return "\\\\";
+        case '\'':
+            return "\\'";
+        }
+        if (c >= ' ' && c <= '~')
+        {
+            return std::string(1, c);
+        }
+        char text[8];
+        std::snprintf(text, sizeof(text), "\\%o", (unsigned char)c);
+        return text;
+    }
+
+    void overflow(size_t line)
+    {
+        std::stringstream ss;
+        ss << "Integer overflow at line " << line << ", the expression is not folded.";
+        context.warning(ss.str());
+    }
+};
+
+#endif // G_CONSTANT_FOLDING_HPP
@@ -0,0 +1,107 @@
+/**
+ * @file    G-Programming-Language/Compiler/context.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_CONTEXT_HPP
+#define G_CONTEXT_HPP
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+/**
+ * State of one compilation: where its messages go and
+ * whether it failed. Every compilation owns its context,
+ * so several of them can run at the same time on
+ * different threads.
+ */
+class CompilationContext
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param out stream for progress and diagnostics
+     * @param err stream for fatal errors of the driver
+     */
+    explicit CompilationContext(std::ostream &out = std::cout, std::ostream &err = std::cerr)
+        : out(out), err(err), diagnostics(out) {}
+
+    /**
+     * Constructor for a compilation whose progress is not shown
+     * but whose errors and warnings are
+     *
+     * @param out         stream for progress
+     * @param err         stream for fatal errors of the driver
+     * @param diagnostics stream for errors and warnings
+     */
+    CompilationContext(std::ostream &out, std::ostream &err, std::ostream &diagnostics)
+        : out(out), err(err), diagnostics(diagnostics) {}
+
+    CompilationContext(const CompilationContext &) = delete;
+    CompilationContext &operator=(const CompilationContext &) = delete;
+
+    /**
+     * Prints the given error message
+     *
+     * @param msg message to print
+     */
+    void error(const std::string &msg)
+    {
+        diagnostics << "[!] " << msg << std::endl;
+    }
+
+    /**
+     * Prints a warning message, which doesn't
+     * oblige to stop the compilation process
+     *
+     * @param msg message to print
+     */
+    void warning(const std::string &msg)
+    {
+        diagnostics << "(!) " << msg << std::endl;
+    }
+
+    /**
+     * Marks the symbol table as not valid
+     */
+    void symbolTableError()
+    {
+        symbolTableOk = false;
+    }
+
+    bool isSymbolTableOk() const
+    {
+        return symbolTableOk;
+    }
+
+    std::ostream &getOutput()
+    {
+        return out;
+    }
+
+    std::ostream &getErrorOutput()
+    {
+        return err;
+    }
+
+private:
+    std::ostream &out;
+
+    std::ostream &err;
+
+    std::ostream &diagnostics;
+
+    /**
+     * False once a symbol is redeclared or used undeclared
+     */
+    bool symbolTableOk = true;
+};
+
+#endif // G_CONTEXT_HPP
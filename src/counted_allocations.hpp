@@ -0,0 +1,66 @@
+/**
+ * @file    G-Programming-Language/Compiler/counted_allocations.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_COUNTED_ALLOCATIONS_HPP
+#define G_COUNTED_ALLOCATIONS_HPP
+#pragma once
+
+#include <cstdlib>
+#include <new>
+#include "./pass_manager.hpp"
+
+/*
+ * Allocation functions that count the allocations of every thread,
+ * see threadAllocations. They replace the ones of the standard
+ * library, so only the file with the main function of an executable
+ * includes this header.
+ */
+
+void *operator new(size_t size)
+{
+    ++threadAllocations();
+    threadAllocatedBytes() += size;
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+#if defined(__GNUC__)
+// inlined next to the counted new, free() looks mismatched to -Wmismatched-new-delete
+__attribute__((noinline))
+#endif
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void *p) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+#endif // G_COUNTED_ALLOCATIONS_HPP
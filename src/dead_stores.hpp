@@ -0,0 +1,154 @@
+/**
+ * @file    G-Programming-Language/Compiler/dead_stores.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_DEAD_STORES_HPP
+#define G_DEAD_STORES_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./interner.hpp"
+#include "./parser_new.hpp"
+
+/**
+ * What dead store elimination removed
+ */
+struct DeadStores
+{
+    /**
+     * Declarations and assignments removed
+     */
+    size_t statements = 0;
+
+    /**
+     * Initialisers removed from declarations that are kept
+     * because the variable is assigned again before being read
+     */
+    size_t initialisers = 0;
+};
+
+/**
+ * Removes the stores whose value is never read: assignments
+ * overwritten before any read, and the declarations of
+ * variables that are never read at all.
+ *
+ * Programs are straight-line code and expressions have no side
+ * effects, so one backward pass computing liveness is exact:
+ * a store is dead if the variable is not live right after it.
+ * A program has no output, so at its end only the variables
+ * whose final value is observed by the caller are live.
+ * The one effect of an expression is stopping the program on a
+ * division by zero, so a store that may divide by zero is kept
+ * whether its value is read or not.
+ *
+ * @param program    root of a valid parse tree
+ * @param observable variables whose final value must be kept
+ * @return what was removed
+ */
+inline DeadStores eliminateDeadStores(const std::shared_ptr<ParseTreeNode> &program, const std::vector<std::string> &observable = {})
+{
+    DeadStores removed;
+    auto root = std::static_pointer_cast<NonTerminalNode>(program);
+    const auto &statements = root->getChildren();
+
+    StringInterner names;
+    // live[id]: the current value of the variable is read later
+    std::vector<char> live;
+    // used[id]: some statement of the variable is kept
+    std::vector<char> used;
+    std::vector<std::string> reads;
+    std::vector<std::shared_ptr<ParseTreeNode>> kept;
+
+    auto idOf = [&](const std::string &name)
+    {
+        uint32_t id = names.intern(name);
+        if (id >= live.size())
+        {
+            live.resize(id + 1, 0);
+            used.resize(id + 1, 0);
+        }
+        return id;
+    };
+    auto read = [&](const std::shared_ptr<ParseTreeNode> &expression)
+    {
+        reads.clear();
+        expression->collectReads(reads);
+        for (const std::string &name : reads)
+        {
+            uint32_t id = idOf(name);
+            live[id] = 1;
+            used[id] = 1;
+        }
+    };
+
+    for (const std::string &name : observable)
+    {
+        live[idOf(name)] = 1;
+    }
+
+    for (size_t i = statements.size(); i-- > 0;)
+    {
+        auto statement = std::static_pointer_cast<NonTerminalNode>(statements[i]);
+        auto node = std::static_pointer_cast<NonTerminalNode>(statement->getChildren().at(0));
+        if (node->getLabel() == "declaration")
+        {
+            node = std::static_pointer_cast<NonTerminalNode>(node->getChildren().at(0));
+            uint32_t id = idOf(node->getValue(1));
+            if (live[id])
+            {
+                live[id] = 0;
+                if (node->getChildren().size() == 3)
+                {
+                    read(node->getChildren()[2]);
+                }
+            }
+            else if (node->getChildren().size() == 3 && node->getChildren()[2]->mayTrap())
+            {
+                read(node->getChildren()[2]);
+            }
+            else if (used[id])
+            {
+                // assigned again before the first read
+                if (node->getChildren().size() == 3)
+                {
+                    node->replaceChildren(2, 1, {});
+                    ++removed.initialisers;
+                }
+            }
+            else
+            {
+                ++removed.statements;
+                continue;
+            }
+        }
+        else
+        {
+            uint32_t id = idOf(node->getValue(0));
+            if (!live[id] && !node->getChildren().at(1)->mayTrap())
+            {
+                ++removed.statements;
+                continue;
+            }
+            // the variable is written before the expression is read
+            live[id] = 0;
+            used[id] = 1;
+            read(node->getChildren().at(1));
+        }
+        kept.push_back(statement);
+    }
+
+    std::reverse(kept.begin(), kept.end());
+    root->replaceChildren(0, statements.size(), kept);
+    return removed;
+}
+
+#endif // G_DEAD_STORES_HPP
@@ -0,0 +1,360 @@
+/**
+ * @file    G-Programming-Language/Compiler/downstream.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_DOWNSTREAM_HPP
+#define G_DOWNSTREAM_HPP
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "./file.hpp"
+
+/**
+ * Objects compiled from generated C++, stored in a directory under
+ * the hash of what they were compiled from: the code, the compiler
+ * command and the version the compiler prints. The same code built
+ * the same way is found again whatever file it was written to.
+ *
+ * Objects are written to a temporary file and renamed, so several
+ * builds can share a directory. Nothing is ever removed from it.
+ */
+class ObjectCache
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param directory where the objects are, created if missing
+     */
+    explicit ObjectCache(std::string directory) : directory(std::move(directory)) {}
+
+    /**
+     * Creates the directory
+     *
+     * @return false if it does not exist and cannot be created
+     */
+    bool open() const
+    {
+        struct stat info
+        {
+        };
+        return mkdir(directory.c_str(), 0755) == 0 ||
+               (stat(directory.c_str(), &info) == 0 && S_ISDIR(info.st_mode));
+    }
+
+    /**
+     * FNV-1a over the bytes of a text
+     *
+     * @param text to hash
+     * @param hash to start from, to hash several texts as one
+     * @return the hash
+     */
+    static uint64_t hash(const std::string &text, uint64_t hash = 14695981039346656037ULL)
+    {
+        for (unsigned char c : text)
+        {
+            hash = (hash ^ c) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /**
+     * Name of the object of some code
+     *
+     * @param code    the object is compiled from
+     * @param command that compiles it, compiler version included
+     * @return the key, the size of the code after the hash to make
+     *         a collision even less likely
+     */
+    static std::string key(const std::string &code, const std::string &command)
+    {
+        char name[40];
+        std::snprintf(name, sizeof(name), "%016llx-%zx",
+                      (unsigned long long)hash(code, hash(command + '\0')), code.size());
+        return name;
+    }
+
+    /**
+     * Path of the object of a key
+     */
+    std::string path(const std::string &key) const
+    {
+        return directory + "/" + key + ".o";
+    }
+
+    /**
+     * Checks if the object of a key was compiled already
+     */
+    bool contains(const std::string &key) const
+    {
+        return access(path(key).c_str(), R_OK) == 0;
+    }
+
+    /**
+     * Path the object of a key is compiled to before being stored,
+     * unique to this process and to the caller
+     *
+     * @param key    of the object
+     * @param worker number of the caller in this process
+     */
+    std::string temporary(const std::string &key, size_t worker) const
+    {
+        return path(key) + ".tmp" + std::to_string(getpid()) + "-" + std::to_string(worker);
+    }
+
+    /**
+     * Stores a compiled object under its key
+     *
+     * @param key       of the object
+     * @param temporary where the object was compiled to
+     * @return false if it could not be moved into the cache
+     */
+    bool store(const std::string &key, const std::string &temporary) const
+    {
+        return std::rename(temporary.c_str(), path(key).c_str()) == 0;
+    }
+
+private:
+    std::string directory;
+};
+
+/**
+ * How the generated C++ is turned into executables
+ */
+struct DownstreamOptions
+{
+    /**
+     * Host compiler
+     */
+    std::string compiler = "c++";
+
+    /**
+     * Flags of every compilation and link, part of the key of the
+     * objects
+     */
+    std::string flags = "-std=c++14 -O2";
+
+    /**
+     * Directory of the objects
+     */
+    std::string cacheDir = ".gcache";
+
+    /**
+     * Number of compilations at once
+     */
+    unsigned jobs = 1;
+};
+
+/**
+ * An executable and the generated C++ files it is linked from
+ */
+struct DownstreamTarget
+{
+    std::string executable;
+    std::vector<std::string> sources;
+};
+
+/**
+ * What building a set of files did
+ */
+struct DownstreamResult
+{
+    size_t built = 0;
+    size_t cached = 0;
+    /**
+     * Files not compiled and executables not linked
+     */
+    size_t failed = 0;
+};
+
+/**
+ * Output of a command, empty if it cannot be run
+ *
+ * @param command to run
+ * @return what it printed on stdout
+ */
+inline std::string commandOutput(const std::string &command)
+{
+    std::string output;
+    FILE *pipe = popen(command.c_str(), "r");
+    if (!pipe)
+    {
+        return output;
+    }
+    char buffer[256];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0)
+    {
+        output.append(buffer, read);
+    }
+    pclose(pipe);
+    return output;
+}
+
+/**
+ * Quotes a word for the shell, whatever chars it has
+ *
+ * @param word to quote
+ * @return the word between single quotes, its own quotes escaped
+ */
+inline std::string shellQuote(const std::string &word)
+{
+    std::string quoted = "'";
+    for (char c : word)
+    {
+        quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+    }
+    return quoted + "'";
+}
+
+/**
+ * Calls a function for every index on up to 'jobs' threads, the
+ * calling one included
+ *
+ * @param count number of indices
+ * @param jobs  number of threads
+ * @param work  called with the index and the number of its thread
+ */
+template <typename Work>
+void parallelFor(size_t count, unsigned jobs, Work work)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&](size_t thread)
+    {
+        for (size_t i = next++; i < count; i = next++)
+        {
+            work(i, thread);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < std::max(1u, jobs) && t < count; ++t)
+    {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * Compiles generated C++ files with the host compiler and links
+ * them into executables. The files of all the targets are taken by
+ * 'jobs' threads; a file whose object is in the cache is not
+ * compiled, so a rebuild of unchanged sources only links.
+ *
+ * @param targets executables to build
+ * @param options of the compiler and of the cache
+ * @param out     stream for progress, written once every file is done
+ * @param err     stream for failures
+ * @return what was built
+ */
+inline DownstreamResult buildExecutables(const std::vector<DownstreamTarget> &targets,
+                                         const DownstreamOptions &options, std::ostream &out, std::ostream &err)
+{
+    DownstreamResult result;
+    ObjectCache cache(options.cacheDir);
+    std::vector<std::string> sources;
+    for (const DownstreamTarget &target : targets)
+    {
+        sources.insert(sources.end(), target.sources.begin(), target.sources.end());
+    }
+    if (!cache.open())
+    {
+        err << "[!] Cannot create the object cache " << options.cacheDir << ".\n";
+        result.failed = sources.size();
+        return result;
+    }
+    // a new compiler version must not reuse the objects of the old one
+    std::string command = options.compiler + " " + options.flags + "\n" +
+                          commandOutput(options.compiler + " --version 2>/dev/null");
+
+    enum class Outcome
+    {
+        BUILT,
+        CACHED,
+        FAILED
+    };
+    std::vector<Outcome> outcomes(sources.size(), Outcome::FAILED);
+    std::vector<std::string> objects(sources.size());
+    std::vector<std::string> logs(sources.size());
+    parallelFor(sources.size(), options.jobs, [&](size_t i, size_t thread)
+                {
+        std::string key = ObjectCache::key(File(sources[i]).read(), command);
+        bool cached = cache.contains(key);
+        if (!cached)
+        {
+            std::string temporary = cache.temporary(key, thread);
+            std::string compile = options.compiler + " " + options.flags + " -c -o " + shellQuote(temporary) + " " +
+                                  shellQuote(sources[i]);
+            if (std::system(compile.c_str()) != 0 || !cache.store(key, temporary))
+            {
+                std::remove(temporary.c_str());
+                logs[i] = "[!] Compilation failed: " + compile + "\n";
+                return;
+            }
+        }
+        objects[i] = cache.path(key);
+        outcomes[i] = cached ? Outcome::CACHED : Outcome::BUILT; });
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        err << logs[i];
+        result.built += outcomes[i] == Outcome::BUILT;
+        result.cached += outcomes[i] == Outcome::CACHED;
+        result.failed += outcomes[i] == Outcome::FAILED;
+    }
+
+    std::vector<size_t> first(targets.size(), 0);
+    for (size_t t = 1; t < targets.size(); ++t)
+    {
+        first[t] = first[t - 1] + targets[t - 1].sources.size();
+    }
+    std::vector<char> linked(targets.size(), 0);
+    logs.assign(targets.size(), "");
+    parallelFor(targets.size(), options.jobs, [&](size_t t, size_t)
+                {
+        const DownstreamTarget &target = targets[t];
+        // flags such as -pthread, -flto or -fsanitize matter to the linker too
+        std::string link = options.compiler + " " + options.flags + " -o " + shellQuote(target.executable);
+        bool cached = true;
+        for (size_t i = first[t]; i < first[t] + target.sources.size(); ++i)
+        {
+            if (outcomes[i] == Outcome::FAILED)
+            {
+                return;
+            }
+            cached = cached && outcomes[i] == Outcome::CACHED;
+            link += " " + shellQuote(objects[i]);
+        }
+        if (std::system(link.c_str()) != 0)
+        {
+            logs[t] = "[!] Linking failed: " + link + "\n";
+            return;
+        }
+        linked[t] = 1;
+        logs[t] = "[i] Executable written: " + target.executable + (cached ? " (cached objects)\n" : "\n"); });
+    for (size_t t = 0; t < targets.size(); ++t)
+    {
+        (linked[t] ? out : err) << logs[t];
+        result.failed += !linked[t] && !logs[t].empty();
+    }
+    return result;
+}
+
+#endif // G_DOWNSTREAM_HPP
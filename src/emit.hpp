@@ -0,0 +1,154 @@
+/**
+ * @file    G-Programming-Language/Compiler/emit.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_EMIT_HPP
+#define G_EMIT_HPP
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include "./lexer.hpp"
+#include "./symbols.hpp"
+
+/**
+ * Buffer the C++ of a program is emitted into. What the code
+ * needs from the headers is noted as it is emitted, so that
+ * the headers are chosen without reading the code again.
+ */
+struct CodeBuffer
+{
+    /**
+     * Code emitted so far
+     */
+    std::string text;
+
+    /**
+     * NULL was emitted, a header must define it
+     */
+    bool usesNull = false;
+};
+
+/**
+ * Appends the C++ code of a literal. The lexer drops the quotes
+ * of string and char literals, here they are put back.
+ *
+ * @param code  buffer the code is appended to
+ * @param type  of the token
+ * @param value of the token
+ */
+inline void appendLiteral(CodeBuffer &code, TokenType type, const std::string &value)
+{
+    char quote = type == TokenType::STRING_LITERAL ? '"' : type == TokenType::CHAR_LITERAL ? '\''
+                                                                                            : 0;
+    if (quote)
+    {
+        code.text += quote;
+    }
+    code.text += value;
+    if (quote)
+    {
+        code.text += quote;
+    }
+    code.usesNull = code.usesNull || type == TokenType::NULL_KEYWORD;
+}
+
+/**
+ * Checks if a token is a literal value
+ *
+ * @param type of the token
+ * @return if it is a literal, NULL included
+ */
+inline bool isLiteralToken(TokenType type)
+{
+    switch (type)
+    {
+    case TokenType::INT_LITERAL:
+    case TokenType::FLOAT_LITERAL:
+    case TokenType::CHAR_LITERAL:
+    case TokenType::STRING_LITERAL:
+    case TokenType::TRUE:
+    case TokenType::FALSE:
+    case TokenType::NULL_KEYWORD:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Qualifier of an initialised declaration. A symbol never
+ * assigned again is const, constexpr if its value is a literal,
+ * so the compiler of the output can fold it into its uses.
+ *
+ * @param symbol  declared, nullptr if unknown
+ * @param literal if the value is a literal
+ * @param value   gives the source of the literal, called only for a float
+ * @return the qualifier and a space, or nothing
+ */
+template <typename LiteralSource>
+inline const char *declarationQualifier(const FrozenSymbol *symbol, bool literal, LiteralSource value)
+{
+    if (!symbol || symbol->reassigned)
+    {
+        return "";
+    }
+    // std::string is not a literal type, and a float out of range
+    // is not a constant expression
+    bool constant = literal && symbol->type != SymbolType::STRING &&
+                    (symbol->type != SymbolType::FLOAT || std::fabs(std::strtod(value().c_str(), nullptr)) <= FLT_MAX);
+    return constant ? "constexpr " : "const ";
+}
+
+/**
+ * Headers the generated code includes
+ */
+enum class HeaderMode
+{
+    /**
+     * <iostream> always, as the first versions of the compiler
+     * did, plus what the program needs: code added to the output
+     * by hand can print
+     */
+    IOSTREAM,
+    /**
+     * Only what the program needs
+     */
+    MINIMAL
+};
+
+/**
+ * Headers needed by a program
+ *
+ * @param symbols  of the program, they give the types declared
+ * @param mode     of the headers
+ * @param usesNull if the code of the program names NULL
+ * @return include directives
+ */
+inline std::string includesFor(const FrozenSymbolTable &symbols, HeaderMode mode, bool usesNull)
+{
+    std::string code = mode == HeaderMode::IOSTREAM ? "#include<iostream>\n" : "";
+    if (symbols.uses(SymbolType::STRING))
+    {
+        code += "#include<string>\n";
+    }
+    if (symbols.isNarrowed())
+    {
+        code += "#include<cstdint>\n";
+    }
+    if (mode == HeaderMode::MINIMAL && usesNull)
+    {
+        // <iostream> defines it too
+        code += "#include<cstddef>\n";
+    }
+    return code;
+}
+
+#endif // G_EMIT_HPP
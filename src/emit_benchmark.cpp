@@ -0,0 +1,110 @@
+/**
+ * @file    G-Programming-Language/Compiler/emit_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * Throughput of the C++ emitter as the program grows.
+ *
+ * Programs of 1k to 1M statements (the first argument changes the
+ * largest) are parsed once and emitted several times; the best time
+ * is kept. The emitter appends to one buffer, so the time and the
+ * allocations per byte of output should stay about the same at
+ * every size; the last column is the time per byte relative to the
+ * smallest program.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./compiler.hpp"
+#include "./counted_allocations.hpp"
+
+using namespace std::chrono;
+
+/**
+ * A program with declarations of every type, assignments and
+ * nested expressions
+ *
+ * @param statements number of statements
+ * @return the source
+ */
+std::string generate(int statements)
+{
+    std::stringstream ss;
+    ss << "int i0 = 7;\nfloat f0 = 1.5;\n";
+    for (int s = 2; s < statements; ++s)
+    {
+        switch (s % 5)
+        {
+        case 0:
+            ss << "int i" << s << " = (i0 + " << s << ") * (i0 - " << s % 7 << ") / 3;\n";
+            break;
+        case 1:
+            ss << "float f" << s << " = -f0 * " << s << ".5 + i0;\n";
+            break;
+        case 2:
+            ss << "boolean b" << s << " = i0 < " << s << " && !(f0 > 1.0);\n";
+            break;
+        case 3:
+            ss << "char c" << s << " = 'g';\n";
+            break;
+        default:
+            ss << "i0 = i0 % " << s << " + 1;\n";
+            break;
+        }
+    }
+    return ss.str();
+}
+
+int main(int argc, char *argv[])
+{
+    int largest = argc > 1 ? std::max(1000, atoi(argv[1])) : 1000000;
+    const int runs = 5;
+
+    std::printf("%10s %12s %10s %9s %10s %12s %8s\n", "statements", "bytes", "emit ms", "MB/s", "ns/byte",
+                "allocs/KB", "scaling");
+    double baseline = 0;
+    for (int statements = 1000; statements <= largest; statements *= 10)
+    {
+        std::ostream quiet(nullptr);
+        CompilationContext context(quiet, quiet);
+        std::string source = generate(statements);
+        Lexer lexer(context, source);
+        std::vector<Token> tokens = lexer.lex();
+        Parser parser(context, tokens);
+        std::shared_ptr<ParseTreeNode> tree = parser.parse(1);
+        if (!parser.isValid())
+        {
+            std::cerr << "[!] The program of " << statements << " statements is not valid.\n";
+            return INVALID_SYNTAX;
+        }
+        CodeGenerator generator(parser.getSymbolTable());
+
+        double best = -1;
+        size_t bytes = 0;
+        size_t allocations = 0;
+        for (int r = 0; r < runs; ++r)
+        {
+            size_t before = threadAllocations();
+            auto start = steady_clock::now();
+            std::string code = generator.generateCode(tree);
+            double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+            allocations = threadAllocations() - before;
+            bytes = code.size();
+            best = best < 0 ? ms : std::min(best, ms);
+        }
+        double nsPerByte = best * 1e6 / bytes;
+        baseline = baseline > 0 ? baseline : nsPerByte;
+        std::printf("%10d %12zu %10.3f %9.1f %10.3f %12.3f %7.2fx\n", statements, bytes, best, bytes / best / 1e3,
+                    nsPerByte, allocations * 1024.0 / bytes, nsPerByte / baseline);
+    }
+    return SUCCESSFUL_COMPILATION;
+}
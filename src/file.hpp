@@ -112,12 +112,13 @@ public:
     /**
      * Writes on the file
      *
-     * @param code to write
+     * @param code      to write
+     * @param extension of the file written, next to the source
      */
-    void write(const std::string &code)
+    void write(const std::string &code, const std::string &extension = ".cpp")
     {
         std::stringstream p;
-        p << path << filename << ".cpp";
+        p << path << filename << extension;
         std::ofstream output(p.str());
         output << code;
         output.close();
@@ -144,25 +145,13 @@ private:
      */
     void setFileName()
     {
-        std::string path = filepath;
-        bool end = false;
-        size_t i = path.length() - 1;
-        while (i && !end)
-        {
-            if (path[i] == '/' || path[i] == '\\')
-            {
-                end = true;
-            }
-            else --i;
-        }
-        this->path = path.substr(0, i + 1);
-        path = path.substr(i + 1, path.length());
-        i = path.size() - 1;
-        while (path[i] != '.')
-        {
-            i--;
-        }
-        this->filename = path.substr(0, i);
+        // a file in the current directory has no path
+        size_t slash = filepath.find_last_of("/\\");
+        this->path = slash == std::string::npos ? "" : filepath.substr(0, slash + 1);
+        std::string name = slash == std::string::npos ? filepath : filepath.substr(slash + 1);
+        // a file without extension keeps its whole name
+        size_t dot = name.find_last_of('.');
+        this->filename = dot == std::string::npos || dot == 0 ? name : name.substr(0, dot);
     }
 };
 
@@ -0,0 +1,395 @@
+/**
+ * @file    G-Programming-Language/Compiler/flat_ast.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_FLAT_AST_HPP
+#define G_FLAT_AST_HPP
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "./lexer.hpp"
+
+/**
+ * Kinds of node of the syntax tree
+ */
+enum class NodeKind : uint32_t
+{
+    PROGRAM,
+    STATEMENT,
+    DECLARATION,
+    ID_DECLARATION,
+    ASSIGNMENT,
+    EXPRESSION,
+    PRIMARY,
+    BINARY,
+    UNARY,
+    TERMINAL
+};
+
+/**
+ * Convert a node label to its kind
+ *
+ * @param label of a non terminal node
+ * @return node kind
+ */
+inline NodeKind nodeKind(const std::string &label)
+{
+    if (label == "program")
+    {
+        return NodeKind::PROGRAM;
+    }
+    else if (label == "statement")
+    {
+        return NodeKind::STATEMENT;
+    }
+    else if (label == "declaration")
+    {
+        return NodeKind::DECLARATION;
+    }
+    else if (label == "id_declaration")
+    {
+        return NodeKind::ID_DECLARATION;
+    }
+    else if (label == "assignment")
+    {
+        return NodeKind::ASSIGNMENT;
+    }
+    else if (label == "expression")
+    {
+        return NodeKind::EXPRESSION;
+    }
+    else if (label == "primary")
+    {
+        return NodeKind::PRIMARY;
+    }
+    return NodeKind::TERMINAL;
+}
+
+/**
+ * Convert a node kind to its label
+ *
+ * @param kind of the node
+ * @return label
+ */
+inline const char *nodeLabel(NodeKind kind)
+{
+    switch (kind)
+    {
+    case NodeKind::PROGRAM:
+        return "program";
+    case NodeKind::STATEMENT:
+        return "statement";
+    case NodeKind::DECLARATION:
+        return "declaration";
+    case NodeKind::ID_DECLARATION:
+        return "id_declaration";
+    case NodeKind::ASSIGNMENT:
+        return "assignment";
+    case NodeKind::EXPRESSION:
+        return "expression";
+    case NodeKind::PRIMARY:
+        return "primary";
+    default:
+        return "";
+    }
+}
+
+/**
+ * Node of the linearised tree. Children always come before
+ * their parent (post-order), so the subtree of the node at
+ * index i is the range [i - size + 1, i].
+ */
+struct FlatNode
+{
+    /**
+     * Kind of the node
+     */
+    NodeKind kind;
+
+    /**
+     * Index in FlatAst::tokens: the lexeme of terminals, the
+     * operator of binary and unary nodes, NO_TOKEN otherwise
+     */
+    uint32_t token;
+
+    /**
+     * Number of direct children
+     */
+    uint32_t childCount;
+
+    /**
+     * Number of nodes in the subtree, the node included
+     */
+    uint32_t size;
+};
+
+/**
+ * Token referenced by a terminal node. The lexeme is
+ * stored in FlatAst::text.
+ */
+struct FlatToken
+{
+    TokenType type;
+    uint32_t line;
+    uint32_t offset;
+    uint32_t length;
+};
+
+static_assert(std::is_trivially_copyable<FlatNode>::value, "FlatNode must be a POD");
+static_assert(std::is_trivially_copyable<FlatToken>::value, "FlatToken must be a POD");
+
+/**
+ * Syntax tree stored as one contiguous array in post-order, to
+ * print and serialise the tree. Every traversal is a linear scan
+ * over 'nodes'. Code generation and the passes run on the parse
+ * tree, which they rewrite in place.
+ */
+class FlatAst
+{
+public:
+    static const uint32_t NO_TOKEN = UINT32_MAX;
+
+    /**
+     * Nodes in post-order, the root is the last one
+     */
+    std::vector<FlatNode> nodes;
+
+    /**
+     * Tokens referenced by terminal nodes
+     */
+    std::vector<FlatToken> tokens;
+
+    /**
+     * All the lexemes, one after the other
+     */
+    std::string text;
+
+    /**
+     * Appends a terminal node
+     *
+     * @param token of the terminal
+     */
+    void addTerminal(const Token &token)
+    {
+        FlatToken ft = {token.type, (uint32_t)token.line, (uint32_t)text.size(), (uint32_t)token.value.size()};
+        text += token.value;
+        tokens.push_back(ft);
+        nodes.push_back({NodeKind::TERMINAL, (uint32_t)tokens.size() - 1, 0, 1});
+    }
+
+    /**
+     * Appends a non terminal node whose children were
+     * the last nodes added
+     *
+     * @param kind       of the node
+     * @param childCount number of children
+     */
+    void addNonTerminal(NodeKind kind, uint32_t childCount)
+    {
+        uint32_t size = 1;
+        size_t child = nodes.size();
+        for (uint32_t i = 0; i < childCount; ++i)
+        {
+            size += nodes[child - 1].size;
+            child -= nodes[child - 1].size;
+        }
+        nodes.push_back({kind, NO_TOKEN, childCount, size});
+    }
+
+    /**
+     * Appends a binary or unary node whose operands were
+     * the last nodes added
+     *
+     * @param kind       BINARY or UNARY
+     * @param op         operator token
+     * @param childCount number of operands
+     */
+    void addOperator(NodeKind kind, const Token &op, uint32_t childCount)
+    {
+        addNonTerminal(kind, childCount);
+        FlatToken ft = {op.type, (uint32_t)op.line, (uint32_t)text.size(), (uint32_t)op.value.size()};
+        text += op.value;
+        tokens.push_back(ft);
+        nodes.back().token = (uint32_t)tokens.size() - 1;
+    }
+
+    /**
+     * Lexeme of a terminal node
+     *
+     * @param node terminal node
+     * @return lexeme
+     */
+    std::string getValue(const FlatNode &node) const
+    {
+        const FlatToken &t = tokens[node.token];
+        return text.substr(t.offset, t.length);
+    }
+
+    /**
+     * Prints the tree, one node per line, indented by depth
+     *
+     * @param out stream to print on
+     */
+    void print(std::ostream &out = std::cout) const
+    {
+        size_t n = nodes.size();
+        std::vector<uint32_t> preorder(n);
+        std::vector<uint32_t> depth(n);
+        // scanning backwards every parent is met before its children,
+        // 'open' keeps how many children each ancestor still has to meet
+        std::vector<uint32_t> open;
+        for (size_t i = n; i-- > 0;)
+        {
+            while (!open.empty() && open.back() == 0)
+            {
+                open.pop_back();
+            }
+            depth[i] = (uint32_t)open.size();
+            if (!open.empty())
+            {
+                --open.back();
+            }
+            open.push_back(nodes[i].childCount);
+            preorder[i - nodes[i].size + 1 + depth[i]] = (uint32_t)i;
+        }
+
+        std::string lines;
+        for (uint32_t i : preorder)
+        {
+            lines.append(depth[i], ' ');
+            if (nodes[i].token != NO_TOKEN)
+            {
+                const FlatToken &t = tokens[nodes[i].token];
+                lines.append(text, t.offset, t.length);
+            }
+            else
+            {
+                lines += nodeLabel(nodes[i].kind);
+            }
+            lines += '\n';
+        }
+        out << lines;
+    }
+
+    /**
+     * Writes the tree in binary form
+     *
+     * @param out stream to write on
+     */
+    void write(std::ostream &out) const
+    {
+        uint32_t header[4] = {MAGIC, (uint32_t)nodes.size(), (uint32_t)tokens.size(), (uint32_t)text.size()};
+        out.write(reinterpret_cast<const char *>(header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(nodes.data()), nodes.size() * sizeof(FlatNode));
+        out.write(reinterpret_cast<const char *>(tokens.data()), tokens.size() * sizeof(FlatToken));
+        out.write(text.data(), text.size());
+    }
+
+    /**
+     * Reads a tree written by FlatAst::write(). The stream must
+     * be seekable, its size bounds the counts of the header.
+     *
+     * @param in stream to read from
+     * @return false if the data is truncated or not a valid tree,
+     *         which is then left empty
+     */
+    bool read(std::istream &in)
+    {
+        uint32_t header[4];
+        if (!in.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] != MAGIC)
+        {
+            return false;
+        }
+        // the counts are checked against what is left before anything is allocated
+        std::streampos start = in.tellg();
+        if (start < 0 || !in.seekg(0, std::ios::end))
+        {
+            return false;
+        }
+        std::streamoff left = in.tellg() - start;
+        in.seekg(start);
+        if (left < 0 ||
+            (uint64_t)header[1] * sizeof(FlatNode) + (uint64_t)header[2] * sizeof(FlatToken) + header[3] >
+                (uint64_t)left)
+        {
+            return false;
+        }
+        nodes.resize(header[1]);
+        tokens.resize(header[2]);
+        text.resize(header[3]);
+        in.read(reinterpret_cast<char *>(nodes.data()), nodes.size() * sizeof(FlatNode));
+        in.read(reinterpret_cast<char *>(tokens.data()), tokens.size() * sizeof(FlatToken));
+        in.read(&text[0], text.size());
+        if (!in || !validate())
+        {
+            nodes.clear();
+            tokens.clear();
+            text.clear();
+            return false;
+        }
+        return true;
+    }
+
+private:
+    /**
+     * "GAST" in little endian
+     */
+    static const uint32_t MAGIC = 0x54534147;
+
+    /**
+     * Checks that the tokens are inside the text and that the nodes
+     * make one tree in post-order, so that nothing read is indexed
+     * out of its array
+     */
+    bool validate() const
+    {
+        for (const FlatToken &token : tokens)
+        {
+            if (token.type > TokenType::_EOF || (uint64_t)token.offset + token.length > text.size())
+            {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            const FlatNode &node = nodes[i];
+            bool hasToken = node.kind == NodeKind::TERMINAL || node.kind == NodeKind::BINARY ||
+                            node.kind == NodeKind::UNARY;
+            if (node.kind > NodeKind::TERMINAL || node.size == 0 || node.size > i + 1 ||
+                (hasToken ? node.token >= tokens.size() : node.token != NO_TOKEN) ||
+                (node.kind == NodeKind::TERMINAL && (node.childCount != 0 || node.size != 1)))
+            {
+                return false;
+            }
+            // the children must fill the subtree exactly
+            size_t begin = i + 1 - node.size;
+            size_t child = i;
+            for (uint32_t c = 0; c < node.childCount; ++c)
+            {
+                if (child <= begin)
+                {
+                    return false;
+                }
+                child -= nodes[child - 1].size;
+            }
+            if (child != begin)
+            {
+                return false;
+            }
+        }
+        return nodes.empty() || nodes.back().size == nodes.size();
+    }
+};
+
+#endif // G_FLAT_AST_HPP
@@ -0,0 +1,234 @@
+/**
+ * @file    G-Programming-Language/Compiler/fold_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * What constant folding saves the host compiler.
+ *
+ * A program of config-style statements (5000 by default, the first
+ * argument changes it) is compiled at -O1 with and without the
+ * 'fold' pass. Half of the statements are literal arithmetic, half
+ * are built from earlier settings, and some settings are overridden
+ * later, so that the host compiler cannot take them as constants.
+ * Range analysis is off in both, so only folding changes the code.
+ * For each: the time of the compiler, the size of the C++, the time
+ * g++ takes to compile it at -O0 and at -O2 (the CXX environment
+ * variable changes the compiler) and the .text of the -O0 object.
+ * The best of several runs is kept.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <elf.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "./compiler.hpp"
+
+using namespace std::chrono;
+
+/**
+ * Deterministic generator, so every run compiles the same program
+ */
+struct Random
+{
+    uint64_t state;
+
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (uint32_t)(state >> 33) % bound;
+    }
+};
+
+/**
+ * A configuration: sizes, limits and ratios computed from literals
+ * and from the settings before them, one statement in eight
+ * overrides an earlier setting
+ *
+ * @param random     generator
+ * @param statements number of statements
+ * @return the source
+ */
+std::string generate(Random &random, int statements)
+{
+    std::stringstream ss;
+    ss << "int c0 = 64;\nfloat r0 = 1.5;\n";
+    std::vector<int> ints = {0};
+    std::vector<int> floats = {0};
+    for (int s = 1; s < statements; ++s)
+    {
+        bool literal = s % 2 == 0;
+        if (s % 8 == 7)
+        {
+            // an override: the setting is no longer a constant for the host compiler
+            ss << "c" << ints[random.next(ints.size())] << " = " << 1 + random.next(64) << " * "
+               << 1 + random.next(1024) << ";\n";
+            continue;
+        }
+        if (random.next(3))
+        {
+            ss << "int c" << s << " = ";
+            if (literal)
+            {
+                ss << 1 + random.next(64) << " * " << 1 + random.next(1024) << " + " << random.next(100);
+            }
+            else
+            {
+                ss << "c" << ints[random.next(ints.size())] << " / " << 1 + random.next(8) << " + c"
+                   << ints[random.next(ints.size())] << " % " << 1 + random.next(16);
+            }
+            ints.push_back(s);
+        }
+        else
+        {
+            ss << "float r" << s << " = ";
+            if (literal)
+            {
+                ss << random.next(10) << ".25 * " << 1 + random.next(4) << ".0 - 0.5";
+            }
+            else
+            {
+                ss << "r" << floats[random.next(floats.size())] << " * 0.5 + c" << ints[random.next(ints.size())];
+            }
+            floats.push_back(s);
+        }
+        ss << ";\n";
+    }
+    return ss.str();
+}
+
+/**
+ * Milliseconds a function takes, the best of some runs
+ *
+ * @param runs number of runs
+ * @param work what is measured, returns false if it failed
+ * @return the time, negative if the work failed
+ */
+template <typename Work>
+double best(int runs, Work work)
+{
+    double fastest = -1;
+    for (int r = 0; r < runs; ++r)
+    {
+        auto start = steady_clock::now();
+        if (!work())
+        {
+            return -1;
+        }
+        double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        fastest = fastest < 0 ? ms : std::min(fastest, ms);
+    }
+    return fastest;
+}
+
+/**
+ * Bytes of the .text sections of an ELF object
+ *
+ * @param path of the object
+ * @return the size, 0 if it cannot be read
+ */
+size_t textBytes(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    Elf64_Ehdr header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.e_shoff == 0 ||
+        header.e_shstrndx >= header.e_shnum)
+    {
+        return 0;
+    }
+    std::vector<Elf64_Shdr> sections(header.e_shnum);
+    in.seekg(header.e_shoff);
+    in.read(reinterpret_cast<char *>(sections.data()), sections.size() * sizeof(Elf64_Shdr));
+    std::string names(sections[header.e_shstrndx].sh_size, '\0');
+    in.seekg(sections[header.e_shstrndx].sh_offset);
+    if (!in.read(&names[0], names.size()))
+    {
+        return 0;
+    }
+    size_t bytes = 0;
+    for (const Elf64_Shdr &section : sections)
+    {
+        const char *name = section.sh_name < names.size() ? names.c_str() + section.sh_name : "";
+        if (std::strcmp(name, ".text") == 0 || std::strncmp(name, ".text.", 6) == 0)
+        {
+            bytes += section.sh_size;
+        }
+    }
+    return bytes;
+}
+
+/**
+ * Size of a file in KB
+ */
+double kilobytes(const std::string &path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? info.st_size / 1024.0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    int statements = argc > 1 ? std::max(10, atoi(argv[1])) : 5000;
+    const char *cxx = std::getenv("CXX");
+    std::string compiler = cxx ? cxx : "g++";
+    const int runs = 3;
+
+    char directory[] = "/tmp/g_fold_benchmark_XXXXXX";
+    if (!mkdtemp(directory))
+    {
+        std::cerr << "[!] Cannot create a temporary directory.\n";
+        return EXIT_FAILURE;
+    }
+    std::string base = std::string(directory) + "/config";
+    Random random = {37};
+    std::ofstream(base + ".g") << generate(random, statements);
+
+    std::printf("%d statements\n", statements);
+    std::printf("%-8s %10s %10s %12s %12s %12s\n", "fold", "gc ms", "C++ KB", "-O0 ms", "-O0 .text KB", "-O2 ms");
+    bool failed = false;
+    for (bool fold : {false, true})
+    {
+        CompileOptions options;
+        options.level = 1;
+        options.disabled = fold ? std::vector<std::string>{"ranges"} : std::vector<std::string>{"fold", "ranges"};
+        double gc = best(runs, [&]
+                         {
+            std::ostream quiet(nullptr);
+            CompilationContext context(quiet, quiet);
+            return compile(base + ".g", options, context) == SUCCESSFUL_COMPILATION; });
+        std::string object = base + ".o";
+        std::string arguments = " -c -o " + shellQuote(object) + " " + shellQuote(base + ".cpp");
+        std::string unoptimised = compiler + " -std=c++14 -O0" + arguments;
+        std::string optimised = compiler + " -std=c++14 -O2" + arguments;
+        double o0 = best(runs, [&] { return std::system(unoptimised.c_str()) == 0; });
+        size_t text = textBytes(object);
+        double o2 = best(runs, [&] { return std::system(optimised.c_str()) == 0; });
+        std::printf("%-8s %10.1f %10.1f %12.1f %12.1f %12.1f\n", fold ? "on" : "off", gc, kilobytes(base + ".cpp"),
+                    o0, text / 1024.0, o2);
+        failed = failed || gc < 0 || o0 < 0 || o2 < 0;
+    }
+
+    for (const char *output : {".g", ".cpp", ".o"})
+    {
+        std::remove((base + output).c_str());
+    }
+    rmdir(directory);
+    if (failed)
+    {
+        std::cerr << "[!] A compilation failed.\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -19,8 +19,10 @@
 
 #include <iostream>
 #include <chrono>
-#include "file.hpp"
-#include "./parser_new.hpp"
+#include <cstdlib>
+#include <sstream>
+#include "./compiler.hpp"
+#include "./counted_allocations.hpp"
 
 using namespace std::chrono;
 
@@ -299,6 +301,25 @@ void print(std::vector<Token> &tokens)
     }
 }
 
+/**
+ * Splits a comma separated list
+ *
+ * @param list  to split
+ * @param items where the items are appended
+ */
+void split(const std::string &list, std::vector<std::string> &items)
+{
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+}
+
 /**
  * End of time measure
  */
@@ -311,103 +332,121 @@ void end_time_measure(std::chrono::_V2::system_clock::time_point t1)
     std::cout << "\n[X] EXECUTION TIME: " << ms_int.count() << " ms\n";
 }
 
-/**
- * Exit codes
- */
-enum exit_codes
-{
-    SUCCESSFUL_COMPILATION,
-    MISSING_ARGUMENT,
-    FILE_DOESNT_EXIST,
-    SOURCE_CODE_IS_EMPTY,
-    NO_TOKENS_FOUND,
-    INVALID_TOKENS,
-    INVALID_SYNTAX,
-    CODE_NOT_GENERATED
-};
-
 int main(int argc, char *argv[])
 {
     auto t1 = high_resolution_clock::now();
 
-    // 2 args necessary
-    if (argc != 2)
-    {
-        std::cout << "[!] Usage: " << argv[0] << " <filepath>" << std::endl;
-        end_time_measure(t1);
-        return MISSING_ARGUMENT;
-    }
-
-    std::cout << "[0] Checking if file exists...\n";
-    std::string path = argv[1];
-    File file(path);
-    if (!file.exists())
+    // at least a filepath necessary, the options are optional
+    std::vector<std::string> paths;
+    CompileOptions options;
+    for (int i = 1; i < argc; ++i)
     {
-        std::cerr << "[!] File does not exist.\n";
-        end_time_measure(t1);
-        return FILE_DOESNT_EXIST;
-    }
-    std::cout << "[1] File found.\n";
-
-    std::cout << "[2] Reading source code...\n";
-    std::string sourcecode = file.read();
-    if (sourcecode.empty())
-    {
-        std::cerr << "[!] File is empty.\n";
-        end_time_measure(t1);
-        return SOURCE_CODE_IS_EMPTY;
-    }
-    std::cout << "[3] Source code read.\n";
-
-    std::cout << "[4] Analysing tokens...\n";
-    Lexer lexer(sourcecode);
-    std::vector<Token> tokens = lexer.lex();
-    if (tokens.empty())
-    {
-        std::cerr << "[!] Error while analyzing tokens. No tokens were found.\n";
-        end_time_measure(t1);
-        return NO_TOKENS_FOUND;
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "-j") == 0)
+        {
+            options.jobs = arg.size() > 2 ? std::max(1, atoi(arg.c_str() + 2)) : std::thread::hardware_concurrency();
+        }
+        else if (arg.size() == 3 && arg.compare(0, 2, "-O") == 0 && arg[2] >= '0' && arg[2] <= '2')
+        {
+            options.level = arg[2] - '0';
+        }
+        else if (arg.compare(0, 15, "--disable-pass=") == 0)
+        {
+            split(arg.substr(15), options.disabled);
+        }
+        else if (arg.compare(0, 14, "--print-after=") == 0)
+        {
+            split(arg.substr(14), options.printAfter);
+        }
+        else if (arg == "--time-passes")
+        {
+            options.timePasses = true;
+        }
+        else if (arg == "--report-ranges")
+        {
+            options.reportRanges = true;
+        }
+        else if (arg == "--evaluate")
+        {
+            options.evaluate = true;
+        }
+        else if (arg == "--backend=cpp" || arg == "--backend=asm")
+        {
+            options.backend = arg == "--backend=asm" ? CompileOptions::Backend::ASM : CompileOptions::Backend::CPP;
+        }
+        else if (arg == "--headers=iostream" || arg == "--headers=minimal")
+        {
+            options.headers = arg == "--headers=minimal" ? HeaderMode::MINIMAL : HeaderMode::IOSTREAM;
+        }
+        else if (arg == "--run")
+        {
+            options.run = true;
+        }
+        else if (arg == "--build")
+        {
+            options.build = true;
+        }
+        else if (arg.compare(0, 6, "--cxx=") == 0)
+        {
+            options.downstream.compiler = arg.substr(6);
+        }
+        else if (arg.compare(0, 11, "--cxxflags=") == 0)
+        {
+            options.downstream.flags = arg.substr(11);
+        }
+        else if (arg.compare(0, 12, "--cache-dir=") == 0)
+        {
+            options.downstream.cacheDir = arg.substr(12);
+        }
+        else if (arg == "--unity" || arg.compare(0, 8, "--unity=") == 0)
+        {
+            options.shards = arg.size() > 8 ? std::max(1, atoi(arg.c_str() + 8)) : 1;
+        }
+        else if (arg.compare(0, 10, "--backend=") == 0)
+        {
+            std::cout << "[!] Unknown backend '" << arg.substr(10) << "', use cpp or asm." << std::endl;
+            end_time_measure(t1);
+            return MISSING_ARGUMENT;
+        }
+        else if (arg.compare(0, 10, "--headers=") == 0)
+        {
+            std::cout << "[!] Unknown headers '" << arg.substr(10) << "', use iostream or minimal." << std::endl;
+            end_time_measure(t1);
+            return MISSING_ARGUMENT;
+        }
+        else
+        {
+            // a directory stands for its .g files
+            std::vector<std::string> sources = sourcesIn(arg);
+            if (sources.empty())
+            {
+                paths.push_back(arg);
+            }
+            paths.insert(paths.end(), sources.begin(), sources.end());
+        }
     }
-
-    // print(tokens);
-
-    if (!lexer.areValid())
+    if (paths.empty())
     {
-        std::cerr << "[!] Error while analyzing tokens. There are invalid tokens.\n";
+        std::cout << "[!] Usage: " << argv[0] << " <filepath>... [-j<jobs>] [-O0|-O1|-O2] [--disable-pass=<passes>]"
+                  << " [--print-after=<passes>|all] [--time-passes]"
+                  << " [--report-ranges] [--evaluate] [--backend=cpp|asm] [--headers=iostream|minimal] [--run]"
+                  << " [--build] [--cxx=<compiler>] [--cxxflags=<flags>] [--cache-dir=<dir>] [--unity[=<shards>]]"
+                  << std::endl;
         end_time_measure(t1);
-        return INVALID_TOKENS;
+        return MISSING_ARGUMENT;
     }
-    std::cout << "[5] Tokens analysed successfully.\n";
-
-    std::cout << "[6] Analysing syntax...\n";
-    Parser parser(tokens);
-    std::shared_ptr<ParseTreeNode> parseTree = parser.parse();
-    if (!parser.isValid())
+    if ((options.build || options.shards) && (options.run || options.backend != CompileOptions::Backend::CPP))
     {
-        // std::cerr << "[!] Error while analyzing syntax. Invalid syntax.\n";
+        std::cout << "[!] --build and --unity use the output of the C++ backend, they cannot be used with --run or"
+                  << " --backend=asm." << std::endl;
         end_time_measure(t1);
-        // print(parser.getTokens());
-        return INVALID_SYNTAX;
+        return MISSING_ARGUMENT;
     }
-    parseTree->print();
-    // print(parser.getTokens());
-    std::cout << "[7] Correct syntax. Abstract Syntax Tree built correctly.\n";
 
-    std::cout << "[8] Generating code...\n";
-    CodeGenerator cg(parser.getSymbolTable());
-    std::string code = cg.generateCode(parseTree);
-    if (code == "")
-    {
-        std::cerr << "[!] Unknown error. Code not generated.\n";
-        end_time_measure(t1);
-        return CODE_NOT_GENERATED;
-    }
-    file.write(code);
-    std::cout << code << "\n";
-    std::cout << "[9] Code generated!\n";
-    std::cout << "[#] Compilation terminated successfully.\n";
+    CompilationContext context;
+    int code = compileFiles(paths, options, context);
 
     end_time_measure(t1);
 
-    return SUCCESSFUL_COMPILATION;
+    return code;
 }
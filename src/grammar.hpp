@@ -0,0 +1,380 @@
+/**
+ * @file    G-Programming-Language/Compiler/grammar.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_GRAMMAR_HPP
+#define G_GRAMMAR_HPP
+#pragma once
+
+#include <cstdint>
+#include "./lexer.hpp"
+#include "./operators.hpp"
+#include "./token_set.hpp"
+
+/**
+ * Non terminals of the grammar in docs/grammar_new.txt.
+ * Repetitions and optional parts are written as extra
+ * right recursive non terminals (STATEMENTS, INITIALISER,
+ * EXPRESSION_TAIL) so that the grammar is LL(1).
+ */
+enum class NonTerminal
+{
+    PROGRAM,
+    STATEMENTS,
+    STATEMENT,
+    DECLARATION,
+    ID_DECLARATION,
+    INITIALISER,
+    DATA_TYPE,
+    ASSIGNMENT,
+    EXPRESSION,
+    EXPRESSION_TAIL,
+    BINARY_OPERATOR,
+    UNARY,
+    PRIMARY
+};
+
+constexpr int NON_TERMINAL_COUNT = (int)NonTerminal::PRIMARY + 1;
+constexpr int TOKEN_TYPE_COUNT = (int)TokenType::_EOF + 1;
+
+/**
+ * Grammar symbols: token types are terminals, non terminals
+ * come right after them
+ */
+constexpr int terminal(TokenType type)
+{
+    return (int)type;
+}
+
+constexpr int nonTerminal(NonTerminal nt)
+{
+    return TOKEN_TYPE_COUNT + (int)nt;
+}
+
+constexpr bool isTerminal(int symbol)
+{
+    return symbol < TOKEN_TYPE_COUNT;
+}
+
+/**
+ * Productions, in the same order as PRODUCTIONS
+ */
+enum class Production : uint8_t
+{
+    PROGRAM,
+    STATEMENTS_MORE,
+    STATEMENTS_END,
+    STATEMENT_DECLARATION,
+    STATEMENT_ASSIGNMENT,
+    DECLARATION,
+    ID_DECLARATION,
+    INITIALISER_ASSIGN,
+    INITIALISER_NONE,
+    DATA_TYPE_BOOLEAN,
+    DATA_TYPE_INT,
+    DATA_TYPE_FLOAT,
+    DATA_TYPE_CHAR,
+    DATA_TYPE_STRING,
+    ASSIGNMENT,
+    EXPRESSION,
+    EXPRESSION_TAIL_MORE,
+    EXPRESSION_TAIL_END,
+    BINARY_OR_CONDITIONAL,
+    BINARY_AND_CONDITIONAL,
+    BINARY_OR_LOGIC,
+    BINARY_XOR_LOGIC,
+    BINARY_AND_LOGIC,
+    BINARY_EQUAL,
+    BINARY_NOT_EQUAL,
+    BINARY_LOWER,
+    BINARY_LOWER_EQUAL,
+    BINARY_GREATER,
+    BINARY_GREATER_EQUAL,
+    BINARY_PLUS,
+    BINARY_MINUS,
+    BINARY_MULTIPLY,
+    BINARY_DIVIDE,
+    BINARY_MODULO,
+    UNARY_MINUS,
+    UNARY_NOT,
+    UNARY_PRIMARY,
+    PRIMARY_INT,
+    PRIMARY_FLOAT,
+    PRIMARY_CHAR,
+    PRIMARY_STRING,
+    PRIMARY_IDENTIFIER,
+    PRIMARY_TRUE,
+    PRIMARY_FALSE,
+    PRIMARY_NULL,
+    PRIMARY_GROUP,
+    NONE = 255
+};
+
+/**
+ * lhs := rhs[0] rhs[1] ... rhs[length - 1]
+ */
+struct GrammarRule
+{
+    int lhs;
+    int rhs[4];
+    int length;
+};
+
+#define G_T(type) terminal(TokenType::type)
+#define G_N(nt) nonTerminal(NonTerminal::nt)
+
+/**
+ * The grammar. Operator precedence is left to the expression
+ * parser (see operators.hpp), so EXPRESSION is a flat list.
+ */
+constexpr GrammarRule PRODUCTIONS[] = {
+    // <program> := <statement>+
+    {G_N(PROGRAM), {G_N(STATEMENT), G_N(STATEMENTS)}, 2},
+    {G_N(STATEMENTS), {G_N(STATEMENT), G_N(STATEMENTS)}, 2},
+    {G_N(STATEMENTS), {}, 0},
+    // <statement> := <declaration> | <assignment>
+    {G_N(STATEMENT), {G_N(DECLARATION)}, 1},
+    {G_N(STATEMENT), {G_N(ASSIGNMENT)}, 1},
+    // <declaration> := <id_declaration>
+    {G_N(DECLARATION), {G_N(ID_DECLARATION)}, 1},
+    // <id_declaration> := <data_type> identifier ('=' <expression>)? ';'
+    {G_N(ID_DECLARATION), {G_N(DATA_TYPE), G_T(IDENTIFIER), G_N(INITIALISER), G_T(SEMICOLON)}, 4},
+    {G_N(INITIALISER), {G_T(ASSIGN), G_N(EXPRESSION)}, 2},
+    {G_N(INITIALISER), {}, 0},
+    // <data_type> := <type_keyword>
+    {G_N(DATA_TYPE), {G_T(BOOLEAN_KEYWORD)}, 1},
+    {G_N(DATA_TYPE), {G_T(INT_KEYWORD)}, 1},
+    {G_N(DATA_TYPE), {G_T(FLOAT_KEYWORD)}, 1},
+    {G_N(DATA_TYPE), {G_T(CHAR_KEYWORD)}, 1},
+    {G_N(DATA_TYPE), {G_T(STRING_KEYWORD)}, 1},
+    // <assignment> := identifier '=' <expression> ';'
+    {G_N(ASSIGNMENT), {G_T(IDENTIFIER), G_T(ASSIGN), G_N(EXPRESSION), G_T(SEMICOLON)}, 4},
+    // <expression> := <unary> (<binary_operator> <unary>)*
+    {G_N(EXPRESSION), {G_N(UNARY), G_N(EXPRESSION_TAIL)}, 2},
+    {G_N(EXPRESSION_TAIL), {G_N(BINARY_OPERATOR), G_N(UNARY), G_N(EXPRESSION_TAIL)}, 3},
+    {G_N(EXPRESSION_TAIL), {}, 0},
+    {G_N(BINARY_OPERATOR), {G_T(OR_CONDITIONAL)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(AND_CONDITIONAL)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(OR_LOGIC)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(XOR_LOGIC)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(AND_LOGIC)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(EQUAL)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(NOT_EQUAL)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(LOWER)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(LOWER_EQUAL)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(GREATER)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(GREATER_EQUAL)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(PLUS)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(MINUS)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(MULTIPLY)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(DIVIDE)}, 1},
+    {G_N(BINARY_OPERATOR), {G_T(MODULO)}, 1},
+    // <unary> := ('-' | '!') <unary> | <primary>
+    {G_N(UNARY), {G_T(MINUS), G_N(UNARY)}, 2},
+    {G_N(UNARY), {G_T(NOT_LOGIC), G_N(UNARY)}, 2},
+    {G_N(UNARY), {G_N(PRIMARY)}, 1},
+    // <primary>
+    {G_N(PRIMARY), {G_T(INT_LITERAL)}, 1},
+    {G_N(PRIMARY), {G_T(FLOAT_LITERAL)}, 1},
+    {G_N(PRIMARY), {G_T(CHAR_LITERAL)}, 1},
+    {G_N(PRIMARY), {G_T(STRING_LITERAL)}, 1},
+    {G_N(PRIMARY), {G_T(IDENTIFIER)}, 1},
+    {G_N(PRIMARY), {G_T(TRUE)}, 1},
+    {G_N(PRIMARY), {G_T(FALSE)}, 1},
+    {G_N(PRIMARY), {G_T(NULL_KEYWORD)}, 1},
+    {G_N(PRIMARY), {G_T(OPEN_PARENTHESIS), G_N(EXPRESSION), G_T(CLOSE_PARENTHESIS)}, 3},
+};
+
+#undef G_T
+#undef G_N
+
+constexpr int PRODUCTION_COUNT = sizeof(PRODUCTIONS) / sizeof(PRODUCTIONS[0]);
+
+static_assert(PRODUCTION_COUNT == (int)Production::PRIMARY_GROUP + 1, "Production must list every rule");
+
+/**
+ * FIRST and FOLLOW sets and the predictive parse table
+ */
+struct LL1Table
+{
+    TokenSet first[NON_TERMINAL_COUNT];
+    bool nullable[NON_TERMINAL_COUNT];
+    TokenSet follow[NON_TERMINAL_COUNT];
+    Production predict[NON_TERMINAL_COUNT][TOKEN_TYPE_COUNT];
+    int conflicts;
+};
+
+/**
+ * FIRST set of part of the right hand side of a rule
+ */
+struct FirstSet
+{
+    TokenSet tokens;
+    bool nullable;
+};
+
+/**
+ * Computes FIRST(rhs[from] ... rhs[length - 1])
+ *
+ * @param table with the FIRST sets computed so far
+ * @param rule  production
+ * @param from  first symbol considered
+ * @return FIRST set and if the sequence can be empty
+ */
+constexpr FirstSet firstOf(const LL1Table &table, const GrammarRule &rule, int from)
+{
+    FirstSet set{TokenSet(), true};
+    for (int i = from; i < rule.length && set.nullable; ++i)
+    {
+        int symbol = rule.rhs[i];
+        if (isTerminal(symbol))
+        {
+            set.tokens |= {(TokenType)symbol};
+            set.nullable = false;
+        }
+        else
+        {
+            set.tokens |= table.first[symbol - TOKEN_TYPE_COUNT];
+            set.nullable = table.nullable[symbol - TOKEN_TYPE_COUNT];
+        }
+    }
+    return set;
+}
+
+/**
+ * Builds FIRST, FOLLOW and the parse table by fixpoint iteration
+ *
+ * @return the table
+ */
+constexpr LL1Table makeLL1Table()
+{
+    LL1Table table{};
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int p = 0; p < PRODUCTION_COUNT; ++p)
+        {
+            int lhs = PRODUCTIONS[p].lhs - TOKEN_TYPE_COUNT;
+            FirstSet set = firstOf(table, PRODUCTIONS[p], 0);
+            if ((table.first[lhs] | set.tokens) != table.first[lhs] || (set.nullable && !table.nullable[lhs]))
+            {
+                table.first[lhs] |= set.tokens;
+                table.nullable[lhs] = table.nullable[lhs] || set.nullable;
+                changed = true;
+            }
+        }
+    }
+
+    table.follow[(int)NonTerminal::PROGRAM] = {TokenType::_EOF};
+    changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int p = 0; p < PRODUCTION_COUNT; ++p)
+        {
+            const GrammarRule &rule = PRODUCTIONS[p];
+            for (int i = 0; i < rule.length; ++i)
+            {
+                if (isTerminal(rule.rhs[i]))
+                {
+                    continue;
+                }
+                int nt = rule.rhs[i] - TOKEN_TYPE_COUNT;
+                FirstSet rest = firstOf(table, rule, i + 1);
+                TokenSet follow = table.follow[nt] | rest.tokens;
+                if (rest.nullable)
+                {
+                    follow |= table.follow[rule.lhs - TOKEN_TYPE_COUNT];
+                }
+                if (follow != table.follow[nt])
+                {
+                    table.follow[nt] = follow;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    for (int nt = 0; nt < NON_TERMINAL_COUNT; ++nt)
+    {
+        for (int t = 0; t < TOKEN_TYPE_COUNT; ++t)
+        {
+            table.predict[nt][t] = Production::NONE;
+        }
+    }
+    for (int p = 0; p < PRODUCTION_COUNT; ++p)
+    {
+        int lhs = PRODUCTIONS[p].lhs - TOKEN_TYPE_COUNT;
+        FirstSet set = firstOf(table, PRODUCTIONS[p], 0);
+        TokenSet tokens = set.nullable ? set.tokens | table.follow[lhs] : set.tokens;
+        for (int t = 0; t < TOKEN_TYPE_COUNT; ++t)
+        {
+            if (!tokens.contains((TokenType)t))
+            {
+                continue;
+            }
+            if (table.predict[lhs][t] != Production::NONE)
+            {
+                ++table.conflicts;
+            }
+            table.predict[lhs][t] = (Production)p;
+        }
+    }
+    return table;
+}
+
+constexpr LL1Table LL1 = makeLL1Table();
+
+static_assert(LL1.conflicts == 0, "the grammar is not LL(1)");
+
+/**
+ * Token classes used by the parser, taken from the grammar
+ */
+constexpr TokenSet DATA_TYPES = LL1.first[(int)NonTerminal::DATA_TYPE];
+constexpr TokenSet EXPRESSION_START = LL1.first[(int)NonTerminal::EXPRESSION];
+constexpr TokenSet PRIMARY_START = LL1.first[(int)NonTerminal::PRIMARY];
+constexpr TokenSet BINARY_OPERATORS = LL1.first[(int)NonTerminal::BINARY_OPERATOR];
+
+static_assert(DATA_TYPES.size() == 5, "DATA_TYPES");
+static_assert(EXPRESSION_START.contains(TokenType::OPEN_PARENTHESIS), "EXPRESSION_START");
+static_assert(EXPRESSION_START.contains(TokenType::NOT_LOGIC), "EXPRESSION_START");
+static_assert(!EXPRESSION_START.contains(TokenType::SEMICOLON), "EXPRESSION_START");
+
+/**
+ * Checks that the operators of the grammar are exactly the
+ * ones with a precedence in operators.hpp
+ */
+constexpr bool operatorsMatchPrecedence()
+{
+    for (int t = 0; t < TOKEN_TYPE_COUNT; ++t)
+    {
+        if (BINARY_OPERATORS.contains((TokenType)t) != (binaryPrecedence((TokenType)t) > 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(operatorsMatchPrecedence(), "binary operators of the grammar and of the precedence table differ");
+
+/**
+ * Production to use for a non terminal given the next token
+ *
+ * @param nt   non terminal to expand
+ * @param type of the next token
+ * @return production, Production::NONE if there is none
+ */
+inline Production predict(NonTerminal nt, TokenType type)
+{
+    return LL1.predict[(int)nt][(int)type];
+}
+
+#endif // G_GRAMMAR_HPP
@@ -0,0 +1,184 @@
+/**
+ * @file    G-Programming-Language/Compiler/gvm.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * 1. read source code
+ * 2. lexycal analysis
+ * 3. syntax analysis (parse tree)
+ * 4. compilation to bytecode, or loading of a .gbc file
+ * 5. execution in the virtual machine
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "./bytecode.hpp"
+#include "./bytecode_file.hpp"
+#include "./compiler.hpp"
+#include "./vm.hpp"
+
+using namespace std::chrono;
+
+/**
+ * Milliseconds since a time
+ */
+double since(steady_clock::time_point start)
+{
+    return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+
+/**
+ * Compiles a source file to bytecode
+ *
+ * @param file     of the source
+ * @param jobs     threads of the parser
+ * @param bytecode where the program is written
+ * @param timing   where the time of every step is printed
+ * @return exit code
+ */
+int build(File &file, unsigned jobs, Bytecode &bytecode, std::ostream &timing)
+{
+    std::string sourcecode = file.read();
+    if (sourcecode.empty())
+    {
+        std::cerr << "[!] File is empty.\n";
+        return SOURCE_CODE_IS_EMPTY;
+    }
+
+    // the program prints its values and the errors, not the steps of the compiler
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, std::cerr, std::cerr);
+    auto start = steady_clock::now();
+    Lexer lexer(context, sourcecode);
+    std::vector<Token> tokens = lexer.lex();
+    if (tokens.empty() || !lexer.areValid())
+    {
+        std::cerr << "[!] Error while analyzing tokens.\n";
+        return tokens.empty() ? NO_TOKENS_FOUND : INVALID_TOKENS;
+    }
+    Parser parser(context, tokens);
+    std::shared_ptr<ParseTreeNode> parseTree = parser.parse(jobs);
+    if (!parser.isValid())
+    {
+        return INVALID_SYNTAX;
+    }
+    timing << "parse    " << since(start) << " ms\n";
+
+    start = steady_clock::now();
+    BytecodeCompiler compiler(*parser.getSymbolTable());
+    if (!compiler.compile(parseTree, bytecode))
+    {
+        std::cerr << "[!] Bytecode not generated: " << compiler.getError() << ".\n";
+        return CODE_NOT_GENERATED;
+    }
+    timing << "compile  " << since(start) << " ms, " << bytecode.code.size() << " instructions, "
+           << bytecode.registers << " registers\n";
+    return SUCCESSFUL_COMPILATION;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path;
+    unsigned jobs = 1;
+    bool dump = false;
+    bool time = false;
+    bool save = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "-j") == 0)
+        {
+            jobs = arg.size() > 2 ? std::max(1, atoi(arg.c_str() + 2)) : std::thread::hardware_concurrency();
+        }
+        else if (arg == "--dump")
+        {
+            dump = true;
+        }
+        else if (arg == "--time")
+        {
+            time = true;
+        }
+        else if (arg == "--save")
+        {
+            save = true;
+        }
+        else
+        {
+            path = arg;
+        }
+    }
+    if (path.empty())
+    {
+        std::cout << "[!] Usage: " << argv[0] << " <filepath.g|filepath.gbc> [-j<jobs>] [--dump] [--time] [--save]"
+                  << std::endl;
+        return MISSING_ARGUMENT;
+    }
+
+    File file(path);
+    if (!file.exists())
+    {
+        std::cerr << "[!] File does not exist.\n";
+        return FILE_DOESNT_EXIST;
+    }
+
+    std::stringstream timing;
+    Bytecode bytecode;
+    BytecodeFile precompiled;
+    BcImage image;
+    bool isBytecode = path.size() > 4 && path.compare(path.size() - 4, 4, ".gbc") == 0;
+    if (isBytecode)
+    {
+        auto start = steady_clock::now();
+        if (!precompiled.load(path))
+        {
+            std::cerr << "[!] " << precompiled.getError() << ".\n";
+            return CODE_NOT_GENERATED;
+        }
+        image = precompiled.getImage();
+        timing << "load     " << since(start) << " ms, " << image.codeSize << " instructions, "
+               << image.registers << " registers\n";
+    }
+    else
+    {
+        int code = build(file, jobs, bytecode, timing);
+        if (code != SUCCESSFUL_COMPILATION)
+        {
+            return code;
+        }
+        image = bytecode.image();
+        if (save && !BytecodeFile::write(bytecode, file.getPath() + file.getFileName() + ".gbc"))
+        {
+            std::cerr << "[!] Cannot write " << file.getPath() << file.getFileName() << ".gbc.\n";
+            return CODE_NOT_GENERATED;
+        }
+    }
+    if (dump)
+    {
+        image.disassemble(std::cout);
+    }
+
+    auto start = steady_clock::now();
+    VirtualMachine vm(image);
+    bool completed = vm.run();
+    timing << "run      " << since(start) << " ms\n";
+    if (!completed)
+    {
+        std::cerr << "[!] Program stopped: " << vm.getError() << ".\n";
+        return PROGRAM_STOPPED;
+    }
+    vm.printValues(std::cout);
+
+    if (time)
+    {
+        std::cerr << timing.str();
+    }
+    return SUCCESSFUL_COMPILATION;
+}
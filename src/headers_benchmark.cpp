@@ -0,0 +1,171 @@
+/**
+ * @file    G-Programming-Language/Compiler/headers_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * Time the downstream compiler takes for one generated file, with
+ * the headers of HeaderMode::IOSTREAM and of HeaderMode::MINIMAL.
+ *
+ * The programs are the .g files given on the command line, or
+ * generated ones of a few sizes. Every file is compiled to an
+ * object file several times and the best time is kept.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./compiler.hpp"
+
+using namespace std::chrono;
+
+/**
+ * A generated program with ints, floats, bools and, if asked,
+ * strings
+ *
+ * @param statements number of declarations
+ * @param strings    if it declares strings
+ * @return the source
+ */
+std::string generate(int statements, bool strings)
+{
+    std::stringstream ss;
+    ss << "int i0 = 7;\nfloat f0 = 1.5;\n";
+    if (strings)
+    {
+        ss << "string s0 = \"g\";\n";
+    }
+    for (int s = 1; s < statements; ++s)
+    {
+        switch (s % (strings ? 4 : 3))
+        {
+        case 0:
+            ss << "int i" << s << " = i0 * " << s << " + " << s % 7 << ";\n";
+            break;
+        case 1:
+            ss << "float f" << s << " = f0 / " << s << ".5 - i0;\n";
+            break;
+        case 2:
+            ss << "boolean b" << s << " = i0 < " << s << " && f0 > 1.0;\n";
+            break;
+        default:
+            ss << "string s" << s << " = s0 + \"" << s << "\";\n";
+            break;
+        }
+    }
+    return ss.str();
+}
+
+/**
+ * C++ of a program, without running any pass
+ *
+ * @param source  of the program
+ * @param headers mode
+ * @return the code, empty if the program is not valid
+ */
+std::string translate(const std::string &source, HeaderMode headers)
+{
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, quiet);
+    Lexer lexer(context, source);
+    std::vector<Token> tokens = lexer.lex();
+    if (tokens.empty() || !lexer.areValid())
+    {
+        return "";
+    }
+    Parser parser(context, tokens);
+    std::shared_ptr<ParseTreeNode> tree = parser.parse(1);
+    if (!parser.isValid())
+    {
+        return "";
+    }
+    return CodeGenerator(parser.getSymbolTable(), headers).generateCode(tree);
+}
+
+/**
+ * Best time to compile a file to an object file
+ *
+ * @param code of the file
+ * @param runs number of compilations
+ * @return milliseconds, negative if it does not compile
+ */
+double compileTime(const std::string &code, int runs)
+{
+    const std::string path = "/tmp/g_headers_benchmark.cpp";
+    std::ofstream(path) << code;
+    double best = -1;
+    for (int r = 0; r < runs; ++r)
+    {
+        auto start = steady_clock::now();
+        int status = std::system(("g++ -std=c++14 -c -o /dev/null " + path).c_str());
+        double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        if (status != 0)
+        {
+            return -1;
+        }
+        best = best < 0 ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    int runs = 5;
+    std::vector<std::pair<std::string, std::string>> programs;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "-r") == 0)
+        {
+            runs = std::max(1, atoi(arg.c_str() + 2));
+            continue;
+        }
+        File file(arg);
+        if (!file.exists())
+        {
+            std::cerr << "[!] " << arg << " does not exist.\n";
+            return FILE_DOESNT_EXIST;
+        }
+        programs.push_back({file.getFileName(), file.read()});
+    }
+    if (programs.empty())
+    {
+        programs = {{"tiny", generate(5, false)},
+                    {"small", generate(50, false)},
+                    {"strings", generate(50, true)},
+                    {"medium", generate(500, false)},
+                    {"large", generate(5000, true)}};
+    }
+
+    std::printf("%-10s %9s | %12s %12s %8s | %s\n", "program", "bytes", "iostream ms", "minimal ms", "speedup",
+                "minimal headers");
+    for (const auto &program : programs)
+    {
+        std::string full = translate(program.second, HeaderMode::IOSTREAM);
+        std::string minimal = translate(program.second, HeaderMode::MINIMAL);
+        if (full.empty())
+        {
+            std::cerr << "[!] " << program.first << " is not valid.\n";
+            return INVALID_SYNTAX;
+        }
+        double fullMs = compileTime(full, runs);
+        double minimalMs = compileTime(minimal, runs);
+        std::string headers;
+        for (size_t at = minimal.find("#include<"); at != std::string::npos; at = minimal.find("#include<", at + 1))
+        {
+            headers += minimal.substr(at + 9, minimal.find('>', at) - at - 9) + " ";
+        }
+        std::printf("%-10s %9zu | %12.1f %12.1f %7.1fx | %s\n", program.first.c_str(), minimal.size(), fullMs,
+                    minimalMs, fullMs / minimalMs, headers.empty() ? "none" : headers.c_str());
+    }
+    return SUCCESSFUL_COMPILATION;
+}
@@ -0,0 +1,636 @@
+/**
+ * @file    G-Programming-Language/Compiler/incremental.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_INCREMENTAL_HPP
+#define G_INCREMENTAL_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "./parser_new.hpp"
+
+/**
+ * Change to the source code: 'length' characters starting
+ * at 'offset' are replaced by 'text'
+ */
+struct Edit
+{
+    size_t offset;
+    size_t length;
+    std::string text;
+};
+
+/**
+ * Keeps the parse tree, the tokens and the symbol table of a
+ * program up to date while it is edited. Statements cannot nest
+ * and end at ';', so the source is split in spans, each one
+ * ending right after a ';': an edit relexes and reparses only
+ * the spans it touches and every other subtree is reused.
+ */
+class IncrementalParser
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param context of the compilation, receives the lexical errors
+     */
+    explicit IncrementalParser(CompilationContext &context) : context(context), st(context) {}
+
+    /**
+     * Parses the whole program
+     *
+     * @param source code
+     * @return root of the parse tree
+     */
+    std::shared_ptr<ParseTreeNode> parse(const std::string &source)
+    {
+        this->source = source;
+        uses.clear();
+        errorsOf.clear();
+        st = SymbolTable(context);
+        invalidStatements = 0;
+        symbolErrors = 0;
+        errors.clear();
+        tree = std::make_shared<NonTerminalNode>("program");
+
+        Region region = parseRegion(0, source.size(), 1);
+        spans = std::move(region.spans);
+        statements = std::move(region.statements);
+        tree->replaceChildren(0, 0, region.nodes);
+        renumber();
+        reparsed = statements.size();
+
+        std::unordered_set<std::string> names;
+        for (auto &statement : statements)
+        {
+            attach(*statement, names);
+        }
+        for (const auto &name : names)
+        {
+            rebuildSymbol(name);
+        }
+        return tree;
+    }
+
+    /**
+     * Applies an edit and reparses the statements it touches
+     *
+     * @param edit to the source code
+     * @return root of the parse tree, the same node as before
+     */
+    std::shared_ptr<ParseTreeNode> reparse(const Edit &edit)
+    {
+        if (statements.empty())
+        {
+            std::string s = source;
+            s.replace(edit.offset, edit.length, edit.text);
+            return parse(s);
+        }
+        errors.clear();
+
+        // spans touched by the edit, in the old source
+        size_t editEnd = edit.offset + edit.length;
+        auto firstIt = std::partition_point(spans.begin(), spans.end() - 1, [&](const Span &span)
+        {
+            return span.end <= edit.offset;
+        });
+        auto lastIt = std::partition_point(firstIt + 1, spans.end(), [&](const Span &span)
+        {
+            return span.begin < editEnd;
+        });
+        size_t first = firstIt - spans.begin();
+        size_t last = lastIt - spans.begin() - 1;
+
+        long delta = (long)edit.text.size() - (long)edit.length;
+        long lineDelta = std::count(edit.text.begin(), edit.text.end(), '\n') -
+                         std::count(source.begin() + edit.offset, source.begin() + editEnd, '\n');
+        source.replace(edit.offset, edit.length, edit.text);
+
+        size_t begin = spans[first].begin;
+        size_t line = spans[first].line;
+        size_t end = spans[last].end + delta;
+        Region region = parseRegion(begin, end, line);
+        // the region must stop where the lexer would stop in the whole
+        // source: right after a ';', otherwise the next spans join it
+        // (twice as many every time, an unterminated comment costs O(n))
+        size_t grow = 1;
+        while (!endsStatement(region, end) && last + 1 < spans.size())
+        {
+            last = std::min(last + grow, spans.size() - 1);
+            grow *= 2;
+            end = spans[last].end + delta;
+            region = parseRegion(begin, end, line);
+        }
+
+        std::unordered_set<std::string> names;
+        size_t child = 0;
+        size_t removedNodes = 0;
+        for (size_t i = 0; i < first; ++i)
+        {
+            child += spans[i].nodeCount;
+        }
+        for (size_t i = first; i <= last; ++i)
+        {
+            removedNodes += spans[i].nodeCount;
+            detach(*statements[i], names);
+        }
+        tree->replaceChildren(child, removedNodes, region.nodes);
+
+        for (size_t i = last + 1; i < spans.size(); ++i)
+        {
+            spans[i].begin += delta;
+            spans[i].end += delta;
+            spans[i].line += lineDelta;
+        }
+        if (lineDelta != 0)
+        {
+            std::unordered_set<std::string> moved;
+            for (size_t i = last + 1; i < spans.size(); ++i)
+            {
+                moveDeclarations(*statements[i], spans[i].line, names, moved);
+            }
+        }
+
+        reparsed = region.statements.size();
+        uint64_t low = first > 0 ? statements[first - 1]->order : 0;
+        uint64_t high = last + 1 < statements.size() ? statements[last + 1]->order : UINT64_MAX;
+        spans.erase(spans.begin() + first, spans.begin() + last + 1);
+        spans.insert(spans.begin() + first, region.spans.begin(), region.spans.end());
+        statements.erase(statements.begin() + first, statements.begin() + last + 1);
+        statements.insert(statements.begin() + first,
+                          std::make_move_iterator(region.statements.begin()),
+                          std::make_move_iterator(region.statements.end()));
+        if (high - low <= reparsed)
+        {
+            renumber();
+        }
+        else
+        {
+            uint64_t step = (high - low) / (reparsed + 1);
+            for (size_t i = 0; i < reparsed; ++i)
+            {
+                statements[first + i]->order = low + step * (i + 1);
+            }
+        }
+        for (size_t i = first; i < first + reparsed; ++i)
+        {
+            attach(*statements[i], names);
+        }
+
+        for (const auto &name : names)
+        {
+            rebuildSymbol(name);
+        }
+        return tree;
+    }
+
+    /**
+     * Token stream of the whole program
+     *
+     * @return tokens, ending with _EOF
+     */
+    std::vector<Token> getTokens() const
+    {
+        std::vector<Token> tokens;
+        for (size_t i = 0; i < statements.size(); ++i)
+        {
+            for (Token token : statements[i]->tokens)
+            {
+                token.offset += spans[i].begin;
+                token.line += spans[i].line;
+                tokens.push_back(token);
+            }
+        }
+        const Span &last = spans.back();
+        size_t line = last.line + std::count(source.begin() + last.begin, source.end(), '\n');
+        tokens.push_back({TokenType::_EOF, "_EOF", line, true, source.size()});
+        return tokens;
+    }
+
+    SymbolTable &getSymbolTable()
+    {
+        return st;
+    }
+
+    const std::string &getSource() const
+    {
+        return source;
+    }
+
+    std::shared_ptr<ParseTreeNode> getTree() const
+    {
+        return tree;
+    }
+
+    /**
+     * Diagnostics of the last parse: syntax errors of the
+     * statements reparsed, then symbol errors of the symbols
+     * they declare, assign or use
+     */
+    const std::vector<std::string> &getErrors() const
+    {
+        return errors;
+    }
+
+    /**
+     * Number of spans parsed by the last call
+     */
+    size_t getReparsedCount() const
+    {
+        return reparsed;
+    }
+
+    bool isValid() const
+    {
+        return invalidStatements == 0 && symbolErrors == 0;
+    }
+
+private:
+    /**
+     * Position of a span of the source code ending right after
+     * a ';' (or at the end of the source). Kept apart from the
+     * rest so that shifting them after an edit is a linear scan.
+     */
+    struct Span
+    {
+        /**
+         * First and one past the last character
+         */
+        size_t begin;
+        size_t end;
+
+        /**
+         * Line of the first character
+         */
+        size_t line;
+
+        /**
+         * Number of statement nodes in the tree
+         */
+        size_t nodeCount;
+    };
+
+    /**
+     * What was parsed from a span
+     */
+    struct Statement
+    {
+        /**
+         * Increasing with the position in the program, it does
+         * not change when other statements are edited
+         */
+        uint64_t order;
+
+        /**
+         * Tokens, with offsets relative to the beginning of
+         * the span and lines relative to its first line
+         */
+        std::vector<Token> tokens;
+
+        /**
+         * Statement nodes, more than one if a ';' was missing
+         */
+        std::vector<std::shared_ptr<ParseTreeNode>> nodes;
+
+        /**
+         * Actions on the symbol table, in order, with lines
+         * relative to the first line of the span
+         */
+        std::vector<DeferredAction> actions;
+
+        /**
+         * If there were no syntax errors
+         */
+        bool valid;
+    };
+
+    /**
+     * Result of parsing part of the source
+     */
+    struct Region
+    {
+        std::vector<Span> spans;
+        std::vector<std::unique_ptr<Statement>> statements;
+        std::vector<std::shared_ptr<ParseTreeNode>> nodes;
+    };
+
+    CompilationContext &context;
+    std::string source;
+    std::shared_ptr<NonTerminalNode> tree;
+    std::vector<Span> spans;
+    std::vector<std::unique_ptr<Statement>> statements;
+    SymbolTable st;
+
+    /**
+     * Statements acting on each symbol
+     */
+    std::unordered_map<std::string, std::vector<Statement *>> uses;
+
+    /**
+     * Symbol errors of each symbol
+     */
+    std::unordered_map<std::string, size_t> errorsOf;
+
+    std::vector<std::string> errors;
+    size_t invalidStatements = 0;
+    size_t symbolErrors = 0;
+    size_t reparsed = 0;
+
+    /**
+     * Spreads the order keys evenly
+     */
+    void renumber()
+    {
+        for (size_t i = 0; i < statements.size(); ++i)
+        {
+            statements[i]->order = (uint64_t)(i + 1) << 32;
+        }
+    }
+
+    /**
+     * Lexes and parses [begin, end) of the source
+     *
+     * @param begin first character
+     * @param end   one past the last character
+     * @param line  of the first character
+     * @return spans found, each ending right after a ';'
+     */
+    Region parseRegion(size_t begin, size_t end, size_t line)
+    {
+        std::string text = source.substr(begin, end - begin);
+        Lexer lexer(context, text, line);
+        std::vector<Token> tokens = lexer.lex();
+
+        Region region;
+        size_t spanBegin = 0;
+        size_t spanLine = line;
+        std::vector<Token> group;
+        for (size_t i = 0; i + 1 < tokens.size(); ++i)
+        {
+            group.push_back(tokens[i]);
+            if (tokens[i].type == TokenType::SEMICOLON)
+            {
+                size_t spanEnd = tokens[i].offset + 1;
+                parseSpan(region, group, begin + spanBegin, begin + spanEnd, spanLine, spanBegin);
+                spanLine += std::count(text.begin() + spanBegin, text.begin() + spanEnd, '\n');
+                spanBegin = spanEnd;
+                group.clear();
+            }
+        }
+        if (spanBegin < text.size() || region.spans.empty())
+        {
+            parseSpan(region, group, begin + spanBegin, end, spanLine, spanBegin);
+        }
+        return region;
+    }
+
+    /**
+     * Parses the tokens of a span and appends it to the region
+     *
+     * @param region     where the span is added
+     * @param tokens     of the span
+     * @param begin      first character
+     * @param end        one past the last character
+     * @param line       of the first character
+     * @param textOffset offset of the tokens relative to 'begin'
+     */
+    void parseSpan(Region &region, std::vector<Token> &tokens, size_t begin, size_t end, size_t line, size_t textOffset)
+    {
+        std::unique_ptr<Statement> statement(new Statement{0, {}, {}, {}, true});
+        if (!tokens.empty())
+        {
+            size_t lastLine = tokens.back().line;
+            tokens.push_back({TokenType::_EOF, "_EOF", lastLine, true, textOffset + (end - begin)});
+            Parser parser(context, tokens, nullptr, &statement->actions);
+            statement->nodes = parser.parseStatements();
+            tokens.pop_back();
+        }
+        for (Token token : tokens)
+        {
+            token.offset -= textOffset;
+            token.line -= line;
+            statement->tokens.push_back(token);
+        }
+        for (auto &action : statement->actions)
+        {
+            if (action.kind == DeferredAction::SYNTAX_ERROR || action.kind == DeferredAction::SYMBOL_ERROR)
+            {
+                statement->valid = false;
+            }
+            action.line -= (int)line;
+        }
+        region.spans.push_back({begin, end, line, statement->nodes.size()});
+        region.nodes.insert(region.nodes.end(), statement->nodes.begin(), statement->nodes.end());
+        region.statements.push_back(std::move(statement));
+    }
+
+    /**
+     * Checks if the region parsed ends right after a ';'
+     */
+    bool endsStatement(const Region &region, size_t end)
+    {
+        if (end == source.size())
+        {
+            return true;
+        }
+        const Statement &last = *region.statements.back();
+        return !last.tokens.empty() &&
+               last.tokens.back().type == TokenType::SEMICOLON &&
+               region.spans.back().end == end;
+    }
+
+    /**
+     * Adds a statement to the index of the symbols and reports
+     * its syntax errors
+     */
+    void attach(Statement &statement, std::unordered_set<std::string> &names)
+    {
+        if (!statement.valid)
+        {
+            ++invalidStatements;
+        }
+        for (const auto &action : statement.actions)
+        {
+            if (action.kind == DeferredAction::SYNTAX_ERROR || action.kind == DeferredAction::SYMBOL_ERROR)
+            {
+                errors.push_back(action.value);
+                continue;
+            }
+            auto &list = uses[action.name];
+            if (list.empty() || list.back() != &statement)
+            {
+                list.push_back(&statement);
+            }
+            names.insert(action.name);
+        }
+    }
+
+    /**
+     * Removes a statement from the index of the symbols
+     */
+    void detach(Statement &statement, std::unordered_set<std::string> &names)
+    {
+        if (!statement.valid)
+        {
+            --invalidStatements;
+        }
+        for (const auto &action : statement.actions)
+        {
+            if (action.kind == DeferredAction::SYNTAX_ERROR || action.kind == DeferredAction::SYMBOL_ERROR)
+            {
+                continue;
+            }
+            auto &list = uses[action.name];
+            list.erase(std::remove(list.begin(), list.end(), &statement), list.end());
+            names.insert(action.name);
+        }
+    }
+
+    /**
+     * First line of the span of a statement
+     */
+    size_t lineOf(const Statement *statement) const
+    {
+        auto it = std::lower_bound(statements.begin(), statements.end(), statement->order,
+                                   [](const std::unique_ptr<Statement> &s, uint64_t order)
+        {
+            return s->order < order;
+        });
+        return spans[it - statements.begin()].line;
+    }
+
+    /**
+     * Replays, in program order, every action on a symbol
+     *
+     * @param name of the symbol
+     */
+    void rebuildSymbol(const std::string &name)
+    {
+        st.removeSymbol(name);
+        symbolErrors -= errorsOf[name];
+        errorsOf[name] = 0;
+
+        auto it = uses.find(name);
+        if (it == uses.end() || it->second.empty())
+        {
+            uses.erase(name);
+            errorsOf.erase(name);
+            return;
+        }
+
+        std::vector<Statement *> &list = it->second;
+        std::sort(list.begin(), list.end(), [](const Statement *a, const Statement *b)
+        {
+            return a->order < b->order;
+        });
+        size_t count = 0;
+        for (const Statement *statement : list)
+        {
+            int line = (int)lineOf(statement);
+            for (DeferredAction action : statement->actions)
+            {
+                if (action.name != name)
+                {
+                    continue;
+                }
+                action.line += line;
+                bool declared = st.isDeclared(name);
+                bool error = action.kind == DeferredAction::ADD_SYMBOL ? declared : !declared;
+                if (error)
+                {
+                    ++count;
+                    errors.push_back(describe(action));
+                }
+                replayQuietly(action);
+            }
+        }
+        errorsOf[name] = count;
+        symbolErrors += count;
+    }
+
+    /**
+     * Updates the line of the symbols declared by a statement that
+     * was moved, if it is the one whose declaration made them. The
+     * moved statements must be given in program order.
+     *
+     * @param statement that was moved
+     * @param spanLine  new first line of its span
+     * @param rebuilt   symbols that will be rebuilt anyway
+     * @param moved     symbols already seen, updated
+     */
+    void moveDeclarations(const Statement &statement, size_t spanLine,
+                          const std::unordered_set<std::string> &rebuilt, std::unordered_set<std::string> &moved)
+    {
+        for (const auto &action : statement.actions)
+        {
+            if (action.kind != DeferredAction::ADD_SYMBOL || rebuilt.count(action.name) ||
+                !moved.insert(action.name).second)
+            {
+                continue;
+            }
+            // a statement before the edit may have declared it first
+            const Statement *declaration = nullptr;
+            for (const Statement *use : uses[action.name])
+            {
+                if ((!declaration || use->order < declaration->order) &&
+                    std::any_of(use->actions.begin(), use->actions.end(), [&](const DeferredAction &a)
+                                { return a.kind == DeferredAction::ADD_SYMBOL && a.name == action.name; }))
+                {
+                    declaration = use;
+                }
+            }
+            if (declaration == &statement)
+            {
+                st.setLine(action.name, action.line + (int)spanLine);
+            }
+        }
+    }
+
+    /**
+     * Applies an action to the symbol table without printing
+     */
+    void replayQuietly(const DeferredAction &action)
+    {
+        if (action.kind == DeferredAction::ADD_SYMBOL && !st.isDeclared(action.name))
+        {
+            st.addSymbol(action.type, action.name, action.line, actionValue(st, action));
+        }
+        else if (action.kind == DeferredAction::SET_VALUE && st.isDeclared(action.name))
+        {
+            st.setValue(action.name, actionValue(st, action), action.line);
+        }
+    }
+
+    /**
+     * Message of a symbol error
+     */
+    std::string describe(const DeferredAction &action)
+    {
+        std::stringstream ss;
+        if (action.kind == DeferredAction::ADD_SYMBOL)
+        {
+            ss << "Variable '" << action.name << "' already declared on line ";
+            ss << st.lookupSymbol(action.name).line << ".";
+        }
+        else
+        {
+            ss << "Undeclared variable '" << action.name << "' was used ";
+            ss << "on line " << action.line << ".";
+        }
+        return ss.str();
+    }
+};
+
+#endif // G_INCREMENTAL_HPP
@@ -0,0 +1,162 @@
+/**
+ * @file    G-Programming-Language/Compiler/incremental_check.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * Checks IncrementalParser against a parse from scratch.
+ *
+ * Random edits are applied to generated programs, with blank lines,
+ * comments, redeclarations and unterminated statements; after every
+ * edit the tree, the tokens, the symbols with their lines and the
+ * validity must be the same as those of a new parse of the edited
+ * source. The first argument is the number of edits, the second the
+ * seed.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./incremental.hpp"
+
+/**
+ * Deterministic generator, so a seed always makes the same edits
+ */
+struct Random
+{
+    uint64_t state;
+
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (uint32_t)(state >> 33) % bound;
+    }
+};
+
+/**
+ * What a parse produced, as text
+ *
+ * @param parser after the parse
+ * @return the tree, the tokens, the symbols sorted by name and
+ *         the validity
+ */
+std::string snapshot(IncrementalParser &parser)
+{
+    std::stringstream tree;
+    std::streambuf *old = std::cout.rdbuf(tree.rdbuf());
+    parser.getTree()->print();
+    std::cout.rdbuf(old);
+
+    std::stringstream tokens;
+    for (const Token &token : parser.getTokens())
+    {
+        tokens << token.value << "@" << token.line << ":" << token.offset << " ";
+    }
+
+    // the table prints its symbols in no particular order
+    std::stringstream table;
+    parser.getSymbolTable().print(table);
+    std::vector<std::string> symbols;
+    std::string line;
+    while (std::getline(table, line))
+    {
+        if (line.compare(0, 9, "Variable:") == 0 || symbols.empty())
+        {
+            symbols.emplace_back();
+        }
+        symbols.back() += line + "\n";
+    }
+    std::sort(symbols.begin(), symbols.end());
+
+    std::string text = tree.str() + "\n" + tokens.str() + "\n";
+    for (const std::string &symbol : symbols)
+    {
+        text += symbol;
+    }
+    return text + (parser.isValid() ? "valid\n" : "not valid\n");
+}
+
+/**
+ * Applies an edit and compares the result with a parse from scratch
+ *
+ * @param parser  to edit
+ * @param edit    to apply
+ * @param context of the parse from scratch
+ * @return false if they differ, after printing the edit
+ */
+bool check(IncrementalParser &parser, const Edit &edit, CompilationContext &context)
+{
+    std::string before = parser.getSource();
+    parser.reparse(edit);
+    IncrementalParser fresh(context);
+    fresh.parse(parser.getSource());
+    if (snapshot(parser) == snapshot(fresh))
+    {
+        return true;
+    }
+    std::cerr << "[!] Mismatch replacing " << edit.length << " chars at " << edit.offset << " with \""
+              << edit.text << "\" in:\n"
+              << before << "\n";
+    return false;
+}
+
+/**
+ * A program of a few statements on a few variables, so that most of
+ * them are redeclared or used before they are declared
+ *
+ * @param random     generator
+ * @param statements number of statements
+ * @return the source
+ */
+std::string generate(Random &random, int statements)
+{
+    static const char *const parts[] = {"int a = 1;", "char q = 'z';", "int c;", "a = c + 1;",
+                                        "float f = 2.5;", "c = a * 2;", "boolean b = a < c;", " ",
+                                        "\n", "\n\n", "// c\n", "/* c */"};
+    std::string source;
+    for (int s = 0; s < statements; ++s)
+    {
+        source += parts[random.next(sizeof(parts) / sizeof(parts[0]))];
+    }
+    return source + "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    int edits = argc > 1 ? std::max(1, atoi(argv[1])) : 2000;
+    Random random = {argc > 2 ? (uint64_t)atoll(argv[2]) : 7};
+
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, quiet);
+    int failed = 0;
+
+    // a newline before declarations moved the line of 'c' twice
+    IncrementalParser parser(context);
+    parser.parse("int a = 1; char q = 'z';\n\n char q = 'z'; int c; int a = 1;\nint c; // c\n\n");
+    failed += !check(parser, {0, 3, "\n"}, context);
+
+    static const char *const texts[] = {"", "\n", "\n\n", ";", "int ", "c", "a", "1", "= ", "int c;",
+                                        "char q = 'z';\n", "/*", "*/", "// c", "\"", " "};
+    for (int e = 0; e < edits; ++e)
+    {
+        if (e % 100 == 0)
+        {
+            parser.parse(generate(random, 10 + random.next(60)));
+        }
+        size_t size = parser.getSource().size();
+        size_t offset = random.next(size + 1);
+        size_t length = random.next(3) == 0 ? std::min<size_t>(random.next(8), size - offset) : 0;
+        failed += !check(parser, {offset, length, texts[random.next(sizeof(texts) / sizeof(texts[0]))]}, context);
+    }
+
+    std::cout << edits + 1 << " edits, " << failed << " mismatches\n";
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
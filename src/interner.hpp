@@ -0,0 +1,140 @@
+/**
+ * @file    G-Programming-Language/Compiler/interner.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_INTERNER_HPP
+#define G_INTERNER_HPP
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Maps every distinct string to a dense id (0, 1, 2, ...).
+ * The hash table is a flat array of slots with linear
+ * probing, so a lookup touches one or two cache lines.
+ * Strings are never removed.
+ */
+class StringInterner
+{
+public:
+    static const uint32_t NO_ID = UINT32_MAX;
+
+    /**
+     * Id of a string, adding it if it is new
+     *
+     * @param s string
+     * @return its id
+     */
+    uint32_t intern(const std::string &s)
+    {
+        if ((strings.size() + 1) * 4 > slots.size() * 3)
+        {
+            grow();
+        }
+        uint32_t hash = hashOf(s);
+        size_t i = probe(s, hash);
+        if (slots[i].id == NO_ID)
+        {
+            slots[i] = {hash, (uint32_t)strings.size()};
+            strings.push_back(s);
+        }
+        return slots[i].id;
+    }
+
+    /**
+     * Id of a string
+     *
+     * @param s string
+     * @return its id, NO_ID if it was never interned
+     */
+    uint32_t find(const std::string &s) const
+    {
+        if (slots.empty())
+        {
+            return NO_ID;
+        }
+        return slots[probe(s, hashOf(s))].id;
+    }
+
+    const std::string &getString(uint32_t id) const
+    {
+        return strings[id];
+    }
+
+    size_t size() const
+    {
+        return strings.size();
+    }
+
+private:
+    struct Slot
+    {
+        uint32_t hash;
+        uint32_t id;
+    };
+
+    /**
+     * Slots, a power of two of them, id NO_ID when empty
+     */
+    std::vector<Slot> slots;
+
+    /**
+     * Strings indexed by id
+     */
+    std::vector<std::string> strings;
+
+    static uint32_t hashOf(const std::string &s)
+    {
+        return (uint32_t)std::hash<std::string>()(s);
+    }
+
+    /**
+     * Finds the slot of a string, or the empty slot where it
+     * would go
+     *
+     * @param s    string
+     * @param hash of the string
+     * @return slot index
+     */
+    size_t probe(const std::string &s, uint32_t hash) const
+    {
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        while (slots[i].id != NO_ID &&
+               (slots[i].hash != hash || strings[slots[i].id] != s))
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old(slots.empty() ? 16 : slots.size() * 2, {0, NO_ID});
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (const Slot &slot : old)
+        {
+            if (slot.id == NO_ID)
+            {
+                continue;
+            }
+            size_t i = slot.hash & mask;
+            while (slots[i].id != NO_ID)
+            {
+                i = (i + 1) & mask;
+            }
+            slots[i] = slot;
+        }
+    }
+};
+
+#endif // G_INTERNER_HPP
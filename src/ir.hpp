@@ -0,0 +1,813 @@
+/**
+ * @file    G-Programming-Language/Compiler/ir.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_IR_HPP
+#define G_IR_HPP
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./interner.hpp"
+#include "./symbols.hpp"
+
+/**
+ * Types of the values of the IR, the C++ types the program
+ * computes with
+ */
+enum class IrType : uint8_t
+{
+    VOID,
+    BOOL,
+    CHAR,
+    INT,
+    FLOAT,
+    DOUBLE,
+    STRING
+};
+
+inline const char *irTypeName(IrType type)
+{
+    switch (type)
+    {
+    case IrType::BOOL:
+        return "bool";
+    case IrType::CHAR:
+        return "char";
+    case IrType::INT:
+        return "int";
+    case IrType::FLOAT:
+        return "float";
+    case IrType::DOUBLE:
+        return "double";
+    case IrType::STRING:
+        return "string";
+    default:
+        return "void";
+    }
+}
+
+/**
+ * IR type of a variable
+ *
+ * @param type of the symbol
+ * @return its type, VOID if it has none
+ */
+inline IrType irTypeOf(SymbolType type)
+{
+    switch (type)
+    {
+    case SymbolType::BOOLEAN:
+        return IrType::BOOL;
+    case SymbolType::INT:
+        return IrType::INT;
+    case SymbolType::FLOAT:
+        return IrType::FLOAT;
+    case SymbolType::CHAR:
+        return IrType::CHAR;
+    case SymbolType::STRING:
+        return IrType::STRING;
+    default:
+        return IrType::VOID;
+    }
+}
+
+/**
+ * Integral promotion: bool and char operands become int
+ */
+inline IrType promote(IrType type)
+{
+    return type == IrType::BOOL || type == IrType::CHAR ? IrType::INT : type;
+}
+
+/**
+ * Type both operands of an arithmetic operation are converted to
+ */
+inline IrType commonType(IrType a, IrType b)
+{
+    if (a == IrType::STRING || b == IrType::STRING)
+    {
+        return IrType::STRING;
+    }
+    if (a == IrType::DOUBLE || b == IrType::DOUBLE)
+    {
+        return IrType::DOUBLE;
+    }
+    if (a == IrType::FLOAT || b == IrType::FLOAT)
+    {
+        return IrType::FLOAT;
+    }
+    return IrType::INT;
+}
+
+enum class Opcode : uint8_t
+{
+    /**
+     * Constant in 'constant'
+     */
+    CONST,
+    /**
+     * Value of a variable never initialised
+     */
+    UNDEF,
+    NEG,
+    NOT,
+    /**
+     * Operand converted to the type of the instruction
+     */
+    CONVERT,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    AND,
+    OR,
+    XOR,
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+    /**
+     * One input per predecessor, in IrProgram::phiInputs
+     */
+    PHI,
+    /**
+     * Jump to block args[0]
+     */
+    BR,
+    /**
+     * Jump to block args[1] if args[0] is true, to args[2] otherwise
+     */
+    CBR,
+    RET
+};
+
+inline const char *opcodeName(Opcode op)
+{
+    static const char *const names[] = {"const", "undef", "neg", "not", "convert", "add", "sub", "mul", "div", "mod",
+                                        "and", "or", "xor", "eq", "ne", "lt", "le", "gt", "ge", "phi", "br", "cbr", "ret"};
+    return names[(int)op];
+}
+
+inline bool isBinary(Opcode op)
+{
+    return op >= Opcode::ADD && op <= Opcode::GE;
+}
+
+inline bool isComparison(Opcode op)
+{
+    return op >= Opcode::EQ && op <= Opcode::GE;
+}
+
+inline bool isTerminator(Opcode op)
+{
+    return op == Opcode::BR || op == Opcode::CBR || op == Opcode::RET;
+}
+
+/**
+ * One instruction. Its index in IrProgram::instructions is
+ * also the id of the value it defines.
+ */
+struct Instruction
+{
+    Opcode op;
+    IrType type;
+    uint32_t line;
+    /**
+     * Operands: value ids, block ids for jumps, first input and
+     * number of inputs for a phi
+     */
+    uint32_t args[3];
+    ConstValue constant;
+};
+
+struct PhiInput
+{
+    uint32_t block;
+    uint32_t value;
+};
+
+/**
+ * Instructions of a basic block, in order. Phis come first,
+ * the last one is the only jump.
+ */
+struct BasicBlock
+{
+    std::vector<uint32_t> code;
+};
+
+/**
+ * Variable of the program and its value at the end
+ */
+struct IrVariable
+{
+    std::string name;
+    IrType type;
+    uint32_t value;
+};
+
+/**
+ * A program in SSA form. Instructions live in one array and
+ * refer to each other by index, so the whole program is a few
+ * allocations and copying it is cheap. Programs have no loops:
+ * blocks only come from '&&' and '||', which skip their right
+ * operand, and the entry is block 0.
+ */
+class IrProgram
+{
+public:
+    static const uint32_t NO_VALUE = UINT32_MAX;
+
+    /**
+     * Default constructor
+     *
+     * @param strings constants the string constants refer to
+     */
+    explicit IrProgram(StringInterner strings = StringInterner()) : strings(std::move(strings)) {}
+
+    uint32_t addBlock()
+    {
+        blocks.emplace_back();
+        return (uint32_t)blocks.size() - 1;
+    }
+
+    /**
+     * Appends an instruction to a block
+     *
+     * @param block       id of the block
+     * @param instruction to append
+     * @return id of its value
+     */
+    uint32_t append(uint32_t block, const Instruction &instruction)
+    {
+        instructions.push_back(instruction);
+        uint32_t id = (uint32_t)instructions.size() - 1;
+        blocks[block].code.push_back(id);
+        return id;
+    }
+
+    /**
+     * Appends a phi to a block
+     *
+     * @param block  id of the block
+     * @param type   of the value
+     * @param inputs one per predecessor
+     * @param line   of the source
+     * @return id of its value
+     */
+    uint32_t appendPhi(uint32_t block, IrType type, const std::vector<PhiInput> &inputs, uint32_t line)
+    {
+        Instruction phi = {Opcode::PHI, type, line, {(uint32_t)phiInputs.size(), (uint32_t)inputs.size(), 0}, ConstValue()};
+        phiInputs.insert(phiInputs.end(), inputs.begin(), inputs.end());
+        return append(block, phi);
+    }
+
+    void addVariable(const std::string &name, IrType type, uint32_t value)
+    {
+        variables.push_back({name, type, value});
+    }
+
+    const Instruction &at(uint32_t id) const
+    {
+        return instructions[id];
+    }
+
+    const std::vector<Instruction> &getInstructions() const
+    {
+        return instructions;
+    }
+
+    const std::vector<BasicBlock> &getBlocks() const
+    {
+        return blocks;
+    }
+
+    const std::vector<IrVariable> &getVariables() const
+    {
+        return variables;
+    }
+
+    const StringInterner &getStrings() const
+    {
+        return strings;
+    }
+
+    StringInterner &getStrings()
+    {
+        return strings;
+    }
+
+    /**
+     * Inputs of a phi
+     *
+     * @param phi instruction
+     * @return pointer to the first of its args[1] inputs
+     */
+    const PhiInput *inputsOf(const Instruction &phi) const
+    {
+        return phiInputs.data() + phi.args[0];
+    }
+
+    /**
+     * Blocks a block jumps to
+     *
+     * @param block id
+     * @return its successors
+     */
+    std::vector<uint32_t> successors(uint32_t block) const
+    {
+        const std::vector<uint32_t> &code = blocks[block].code;
+        if (code.empty())
+        {
+            return {};
+        }
+        const Instruction &last = instructions[code.back()];
+        if (last.op == Opcode::BR)
+        {
+            return {last.args[0]};
+        }
+        if (last.op == Opcode::CBR)
+        {
+            return {last.args[1], last.args[2]};
+        }
+        return {};
+    }
+
+    /**
+     * Predecessors of every block
+     */
+    std::vector<std::vector<uint32_t>> predecessors() const
+    {
+        std::vector<std::vector<uint32_t>> preds(blocks.size());
+        for (uint32_t b = 0; b < blocks.size(); ++b)
+        {
+            for (uint32_t s : successors(b))
+            {
+                if (s < blocks.size())
+                {
+                    preds[s].push_back(b);
+                }
+            }
+        }
+        return preds;
+    }
+
+    /**
+     * Prints the program as text, one instruction per line
+     *
+     * @param out stream to print to
+     */
+    void dump(std::ostream &out) const
+    {
+        std::vector<std::vector<uint32_t>> preds = predecessors();
+        for (uint32_t b = 0; b < blocks.size(); ++b)
+        {
+            out << "b" << b << ":";
+            if (!preds[b].empty())
+            {
+                out << "\t\t\t; preds";
+                for (uint32_t p : preds[b])
+                {
+                    out << " b" << p;
+                }
+            }
+            out << "\n";
+            for (uint32_t id : blocks[b].code)
+            {
+                out << "    " << text(id) << "\n";
+            }
+        }
+        for (const IrVariable &variable : variables)
+        {
+            out << "; " << variable.name << " = " << valueName(variable.value) << "\n";
+        }
+    }
+
+    /**
+     * Checks that the program is well formed: every block ends
+     * with its only jump, phis come first and have one input per
+     * predecessor, types match, and every value is defined in a
+     * place that dominates its uses
+     *
+     * @return a message for each problem, empty if there are none
+     */
+    std::vector<std::string> verify() const
+    {
+        std::vector<std::string> errors;
+        auto fail = [&](uint32_t id, const std::string &msg)
+        {
+            errors.push_back(id == NO_VALUE ? msg : "'" + text(id) + "': " + msg);
+        };
+        if (blocks.empty())
+        {
+            fail(NO_VALUE, "the program has no blocks");
+            return errors;
+        }
+
+        // where every value is defined
+        std::vector<uint32_t> blockOf(instructions.size(), (uint32_t)NO_VALUE);
+        std::vector<uint32_t> position(instructions.size(), 0);
+        for (uint32_t b = 0; b < blocks.size(); ++b)
+        {
+            const std::vector<uint32_t> &code = blocks[b].code;
+            if (code.empty() || !isTerminator(instructions[code.back()].op))
+            {
+                fail(NO_VALUE, "block b" + std::to_string(b) + " does not end with a jump");
+            }
+            for (uint32_t i = 0; i < code.size(); ++i)
+            {
+                if (code[i] >= instructions.size() || blockOf[code[i]] != NO_VALUE)
+                {
+                    fail(NO_VALUE, "block b" + std::to_string(b) + " has an instruction out of range or in two blocks");
+                    return errors;
+                }
+                blockOf[code[i]] = b;
+                position[code[i]] = i;
+            }
+        }
+        for (uint32_t id = 0; id < instructions.size(); ++id)
+        {
+            if (blockOf[id] == NO_VALUE)
+            {
+                fail(id, "not in any block");
+            }
+        }
+        if (!errors.empty())
+        {
+            return errors;
+        }
+
+        std::vector<std::vector<uint32_t>> preds = predecessors();
+        std::vector<uint32_t> idom = dominators(preds);
+        for (uint32_t b = 1; b < blocks.size(); ++b)
+        {
+            if (idom[b] == NO_VALUE)
+            {
+                fail(NO_VALUE, "block b" + std::to_string(b) + " is unreachable");
+            }
+        }
+        // a value used at 'position' of 'block' must be defined before
+        auto available = [&](uint32_t value, uint32_t block, uint32_t at)
+        {
+            if (value >= instructions.size())
+            {
+                return false;
+            }
+            uint32_t def = blockOf[value];
+            if (def == block)
+            {
+                return position[value] < at;
+            }
+            for (uint32_t b = block; b != 0 && idom[b] != NO_VALUE;)
+            {
+                b = idom[b];
+                if (b == def)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        auto typeOf = [&](uint32_t value)
+        {
+            return value < instructions.size() ? instructions[value].type : IrType::VOID;
+        };
+
+        for (uint32_t b = 0; b < blocks.size(); ++b)
+        {
+            const std::vector<uint32_t> &code = blocks[b].code;
+            bool phis = true;
+            for (uint32_t i = 0; i < code.size(); ++i)
+            {
+                uint32_t id = code[i];
+                const Instruction &instruction = instructions[id];
+                Opcode op = instruction.op;
+                IrType type = instruction.type;
+                if (op != Opcode::PHI)
+                {
+                    phis = false;
+                }
+                else if (!phis)
+                {
+                    fail(id, "phi after other instructions");
+                }
+                if (isTerminator(op) && i + 1 != code.size())
+                {
+                    fail(id, "jump in the middle of a block");
+                }
+
+                // operands
+                unsigned count = 0;
+                if (op == Opcode::NEG || op == Opcode::NOT || op == Opcode::CONVERT || op == Opcode::CBR)
+                {
+                    count = 1;
+                }
+                else if (isBinary(op))
+                {
+                    count = 2;
+                }
+                for (unsigned a = 0; a < count; ++a)
+                {
+                    if (!available(instruction.args[a], b, i))
+                    {
+                        fail(id, "operand %" + std::to_string(instruction.args[a]) + " is not defined before its use");
+                    }
+                }
+
+                switch (op)
+                {
+                case Opcode::CONST:
+                {
+                    ConstValue::Kind kind = type == IrType::STRING ? ConstValue::STRING
+                                            : type == IrType::FLOAT || type == IrType::DOUBLE
+                                                ? ConstValue::FLOAT
+                                                : ConstValue::INT;
+                    if (type == IrType::VOID || instruction.constant.kind != kind)
+                    {
+                        fail(id, "constant of the wrong kind");
+                    }
+                    break;
+                }
+                case Opcode::UNDEF:
+                    if (type == IrType::VOID)
+                    {
+                        fail(id, "void value");
+                    }
+                    break;
+                case Opcode::NEG:
+                    if ((type != IrType::INT && type != IrType::FLOAT && type != IrType::DOUBLE) || typeOf(instruction.args[0]) != type)
+                    {
+                        fail(id, "operand and result must be the same int or floating type");
+                    }
+                    break;
+                case Opcode::NOT:
+                    if (type != IrType::BOOL || typeOf(instruction.args[0]) != IrType::BOOL)
+                    {
+                        fail(id, "operand and result must be bool");
+                    }
+                    break;
+                case Opcode::CONVERT:
+                    if (type == IrType::VOID || typeOf(instruction.args[0]) == IrType::VOID)
+                    {
+                        fail(id, "conversion from or to void");
+                    }
+                    break;
+                case Opcode::PHI:
+                {
+                    const PhiInput *inputs = inputsOf(instruction);
+                    if (instruction.args[0] + instruction.args[1] > phiInputs.size() || instruction.args[1] != preds[b].size())
+                    {
+                        fail(id, "needs one input per predecessor");
+                        break;
+                    }
+                    for (uint32_t p = 0; p < instruction.args[1]; ++p)
+                    {
+                        const PhiInput &input = inputs[p];
+                        bool isPred = false;
+                        for (uint32_t pred : preds[b])
+                        {
+                            isPred = isPred || pred == input.block;
+                        }
+                        if (!isPred)
+                        {
+                            fail(id, "input from b" + std::to_string(input.block) + ", which is not a predecessor");
+                        }
+                        else if (!available(input.value, input.block, (uint32_t)blocks[input.block].code.size()))
+                        {
+                            fail(id, "input %" + std::to_string(input.value) + " is not defined at the end of b" + std::to_string(input.block));
+                        }
+                        else if (typeOf(input.value) != type)
+                        {
+                            fail(id, "input of a different type");
+                        }
+                    }
+                    break;
+                }
+                case Opcode::BR:
+                case Opcode::CBR:
+                case Opcode::RET:
+                    if (type != IrType::VOID)
+                    {
+                        fail(id, "jumps have no value");
+                    }
+                    if (op == Opcode::CBR && typeOf(instruction.args[0]) != IrType::BOOL)
+                    {
+                        fail(id, "condition must be bool");
+                    }
+                    for (uint32_t target : successors(b))
+                    {
+                        if (target >= blocks.size() || target == 0)
+                        {
+                            fail(id, "jump to a block that does not exist or to the entry");
+                        }
+                    }
+                    break;
+                default:
+                {
+                    IrType lhs = typeOf(instruction.args[0]);
+                    IrType rhs = typeOf(instruction.args[1]);
+                    if (lhs != rhs || lhs == IrType::VOID)
+                    {
+                        fail(id, "operands of different types");
+                    }
+                    else if (isComparison(op) ? type != IrType::BOOL : type != lhs)
+                    {
+                        fail(id, "result of the wrong type");
+                    }
+                    else if (op >= Opcode::MOD && op <= Opcode::XOR && type != IrType::INT)
+                    {
+                        fail(id, "integer operation on another type");
+                    }
+                    else if (op != Opcode::ADD && !isComparison(op) && type == IrType::STRING)
+                    {
+                        fail(id, "strings can only be added");
+                    }
+                    break;
+                }
+                }
+            }
+        }
+
+        for (const IrVariable &variable : variables)
+        {
+            if (variable.value != NO_VALUE && typeOf(variable.value) != variable.type)
+            {
+                errors.push_back("variable '" + variable.name + "' holds a value of a different type");
+            }
+        }
+        return errors;
+    }
+
+private:
+    /**
+     * All the instructions of the program
+     */
+    std::vector<Instruction> instructions;
+
+    /**
+     * Inputs of all the phis, every phi owns a range
+     */
+    std::vector<PhiInput> phiInputs;
+
+    std::vector<BasicBlock> blocks;
+
+    std::vector<IrVariable> variables;
+
+    /**
+     * String constants
+     */
+    StringInterner strings;
+
+    static std::string valueName(uint32_t value)
+    {
+        return value == NO_VALUE ? "undef" : "%" + std::to_string(value);
+    }
+
+    /**
+     * Text of an instruction
+     */
+    std::string text(uint32_t id) const
+    {
+        const Instruction &instruction = instructions[id];
+        std::stringstream ss;
+        Opcode op = instruction.op;
+        if (instruction.type != IrType::VOID)
+        {
+            ss << valueName(id) << " = ";
+        }
+        ss << opcodeName(op);
+        if (instruction.type != IrType::VOID)
+        {
+            ss << " " << irTypeName(instruction.type);
+        }
+        if (op == Opcode::CONST)
+        {
+            ss << " " << describe(instruction.constant, strings);
+        }
+        else if (op == Opcode::NEG || op == Opcode::NOT || op == Opcode::CONVERT)
+        {
+            ss << " " << valueName(instruction.args[0]);
+        }
+        else if (isBinary(op))
+        {
+            ss << " " << valueName(instruction.args[0]) << ", " << valueName(instruction.args[1]);
+        }
+        else if (op == Opcode::PHI)
+        {
+            const PhiInput *inputs = inputsOf(instruction);
+            for (uint32_t p = 0; p < instruction.args[1] && instruction.args[0] + p < phiInputs.size(); ++p)
+            {
+                ss << (p ? ", [" : " [") << valueName(inputs[p].value) << ", b" << inputs[p].block << "]";
+            }
+        }
+        else if (op == Opcode::BR)
+        {
+            ss << " b" << instruction.args[0];
+        }
+        else if (op == Opcode::CBR)
+        {
+            ss << " " << valueName(instruction.args[0]) << ", b" << instruction.args[1] << ", b" << instruction.args[2];
+        }
+        return ss.str();
+    }
+
+    /**
+     * Immediate dominators, with the iterative algorithm of
+     * Cooper, Harvey and Kennedy
+     *
+     * @param preds predecessors of every block
+     * @return immediate dominator of every block, NO_VALUE if
+     *         the block is unreachable; the entry is its own
+     */
+    std::vector<uint32_t> dominators(const std::vector<std::vector<uint32_t>> &preds) const
+    {
+        // reverse post-order
+        std::vector<uint32_t> order;
+        std::vector<char> visited(blocks.size(), 0);
+        std::vector<std::pair<uint32_t, size_t>> stack = {{0, 0}};
+        visited[0] = 1;
+        while (!stack.empty())
+        {
+            uint32_t b = stack.back().first;
+            std::vector<uint32_t> next = successors(b);
+            if (stack.back().second < next.size())
+            {
+                uint32_t s = next[stack.back().second++];
+                if (s < blocks.size() && !visited[s])
+                {
+                    visited[s] = 1;
+                    stack.push_back({s, 0});
+                }
+                continue;
+            }
+            order.push_back(b);
+            stack.pop_back();
+        }
+        std::vector<uint32_t> rank(blocks.size(), (uint32_t)NO_VALUE);
+        for (uint32_t i = 0; i < order.size(); ++i)
+        {
+            rank[order[i]] = i;
+        }
+
+        std::vector<uint32_t> idom(blocks.size(), (uint32_t)NO_VALUE);
+        idom[0] = 0;
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (size_t i = order.size(); i-- > 0;)
+            {
+                uint32_t b = order[i];
+                if (b == 0)
+                {
+                    continue;
+                }
+                uint32_t dom = NO_VALUE;
+                for (uint32_t p : preds[b])
+                {
+                    if (idom[p] == NO_VALUE)
+                    {
+                        continue;
+                    }
+                    if (dom == NO_VALUE)
+                    {
+                        dom = p;
+                        continue;
+                    }
+                    // the post-order rank grows towards the entry
+                    uint32_t x = p;
+                    while (x != dom)
+                    {
+                        while (rank[x] < rank[dom])
+                        {
+                            x = idom[x];
+                        }
+                        while (rank[dom] < rank[x])
+                        {
+                            dom = idom[dom];
+                        }
+                    }
+                }
+                if (dom != idom[b])
+                {
+                    idom[b] = dom;
+                    changed = true;
+                }
+            }
+        }
+        return idom;
+    }
+};
+
+#endif // G_IR_HPP
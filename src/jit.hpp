@@ -0,0 +1,700 @@
+/**
+ * @file    G-Programming-Language/Compiler/jit.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_JIT_HPP
+#define G_JIT_HPP
+#pragma once
+
+#include <csetjmp>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "./ir.hpp"
+
+/**
+ * A program assembled into memory and run inside the compiler.
+ *
+ * It takes the assembly of AsmGenerator, without '_start', so
+ * both backends share the instruction selection: only the
+ * instructions and directives AsmGenerator writes are known.
+ * The code and its constants are written to an anonymous
+ * mapping that is then made executable and read only, the
+ * variables get a separate writable one: no page is ever both
+ * writable and executable.
+ */
+class JitProgram
+{
+public:
+    JitProgram() = default;
+
+    JitProgram(const JitProgram &) = delete;
+
+    JitProgram &operator=(const JitProgram &) = delete;
+
+    ~JitProgram()
+    {
+        if (image)
+        {
+            munmap(image, imageSize);
+        }
+    }
+
+    /**
+     * Assembles a program and maps it
+     *
+     * @param assembly written by AsmGenerator::generate(false)
+     * @return false if it could not be, see getError
+     */
+    bool load(const std::string &assembly)
+    {
+        size_t begin = 0;
+        while (begin < assembly.size())
+        {
+            size_t end = assembly.find('\n', begin);
+            if (end == std::string::npos)
+            {
+                end = assembly.size();
+            }
+            if (!assembleLine(assembly.substr(begin, end - begin)))
+            {
+                return false;
+            }
+            begin = end + 1;
+        }
+        return map();
+    }
+
+    /**
+     * Why the program could not be loaded
+     */
+    const std::string &getError() const
+    {
+        return error;
+    }
+
+    /**
+     * Bytes of machine code
+     */
+    size_t getCodeSize() const
+    {
+        return sections[TEXT].size();
+    }
+
+    /**
+     * Address of a label of the program
+     *
+     * @param name of the label
+     * @return nullptr if there is no such label
+     */
+    void *address(const std::string &name) const
+    {
+        auto it = labels.find(name);
+        if (!image || it == labels.end())
+        {
+            return nullptr;
+        }
+        return image + base[it->second.section] + it->second.offset;
+    }
+
+    /**
+     * Runs the program, 'g_main'. An integer division the
+     * hardware traps, by zero or INT_MIN / -1, stops it.
+     *
+     * @return false if the program was stopped
+     */
+    bool run()
+    {
+        auto entry = reinterpret_cast<void (*)()>(address("g_main"));
+        struct sigaction trap = {}, previous = {};
+        trap.sa_handler = [](int)
+        {
+            siglongjmp(**fault(), 1);
+        };
+        sigemptyset(&trap.sa_mask);
+        sigaction(SIGFPE, &trap, &previous);
+        sigjmp_buf here;
+        *fault() = &here;
+        volatile bool completed = false;
+        if (sigsetjmp(here, 1) == 0)
+        {
+            entry();
+            completed = true;
+        }
+        *fault() = nullptr;
+        sigaction(SIGFPE, &previous, nullptr);
+        return completed;
+    }
+
+private:
+    enum Section
+    {
+        TEXT,
+        RODATA,
+        BSS
+    };
+
+    struct Label
+    {
+        Section section;
+        size_t offset;
+    };
+
+    /**
+     * 32 bit displacement in the code to a label, relative to
+     * the end of its instruction
+     */
+    struct Fixup
+    {
+        size_t at;
+        size_t end;
+        std::string label;
+    };
+
+    struct Operand
+    {
+        enum Kind
+        {
+            REGISTER,
+            XMM,
+            MEMORY,
+            IMMEDIATE,
+            LABEL
+        };
+
+        Kind kind;
+        int reg = 0;
+        int64_t value = 0;
+        /**
+         * Label of a %rip relative operand, or of a jump
+         */
+        std::string label;
+    };
+
+    std::vector<uint8_t> sections[2];
+    size_t bssSize = 0;
+    Section section = TEXT;
+    std::unordered_map<std::string, Label> labels;
+    std::vector<Fixup> fixups;
+    std::string error;
+
+    uint8_t *image = nullptr;
+    size_t imageSize = 0;
+    size_t base[3] = {0, 0, 0};
+
+    /**
+     * Where a fault jumps back to, for the running thread
+     */
+    static sigjmp_buf **fault()
+    {
+        thread_local sigjmp_buf *jump = nullptr;
+        return &jump;
+    }
+
+    std::vector<uint8_t> &text()
+    {
+        return sections[TEXT];
+    }
+
+    bool fail(const std::string &why, const std::string &line)
+    {
+        error = why + ": '" + line + "'";
+        return false;
+    }
+
+    bool map()
+    {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        base[RODATA] = (sections[TEXT].size() + 15) / 16 * 16;
+        base[BSS] = (base[RODATA] + sections[RODATA].size() + page - 1) / page * page;
+        imageSize = base[BSS] + (bssSize + page - 1) / page * page;
+        void *memory = mmap(nullptr, imageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+            error = "cannot map " + std::to_string(imageSize) + " bytes";
+            return false;
+        }
+        image = static_cast<uint8_t *>(memory);
+        std::memcpy(image, sections[TEXT].data(), sections[TEXT].size());
+        std::memcpy(image + base[RODATA], sections[RODATA].data(), sections[RODATA].size());
+        for (const Fixup &fixup : fixups)
+        {
+            auto it = labels.find(fixup.label);
+            if (it == labels.end())
+            {
+                error = "undefined label '" + fixup.label + "'";
+                return false;
+            }
+            int32_t displacement = (int32_t)(base[it->second.section] + it->second.offset - fixup.end);
+            std::memcpy(image + fixup.at, &displacement, sizeof(displacement));
+        }
+        if (mprotect(image, base[BSS], PROT_READ | PROT_EXEC) != 0)
+        {
+            error = "cannot make the code executable";
+            return false;
+        }
+        return true;
+    }
+
+    bool assembleLine(std::string line)
+    {
+        size_t first = line.find_first_not_of('\t');
+        if (first == std::string::npos)
+        {
+            return true;
+        }
+        line.erase(0, first);
+        if (line.back() == ':')
+        {
+            labels[line.substr(0, line.size() - 1)] = {section, section == BSS ? bssSize : sections[section].size()};
+            return true;
+        }
+        size_t tab = line.find('\t');
+        std::string mnemonic = line.substr(0, tab);
+        std::string rest = tab == std::string::npos ? "" : line.substr(tab + 1);
+        if (mnemonic[0] == '.')
+        {
+            return directive(mnemonic, rest, line);
+        }
+
+        std::vector<Operand> operands;
+        size_t begin = 0;
+        while (begin < rest.size())
+        {
+            size_t comma = rest.find(", ", begin);
+            if (comma == std::string::npos)
+            {
+                comma = rest.size();
+            }
+            Operand operand;
+            if (!parseOperand(rest.substr(begin, comma - begin), operand))
+            {
+                return fail("unknown operand", line);
+            }
+            operands.push_back(operand);
+            begin = comma + 2;
+        }
+        return instruction(mnemonic, operands) || fail("unknown instruction", line);
+    }
+
+    bool directive(const std::string &name, const std::string &arguments, const std::string &line)
+    {
+        if (name == ".text" || name == ".bss" || name == ".section")
+        {
+            section = name == ".text" ? TEXT : name == ".bss" ? BSS
+                                           : arguments == ".rodata" ? RODATA
+                                                                    : section;
+        }
+        else if (name == ".align")
+        {
+            size_t alignment = std::stoul(arguments);
+            if (section == BSS)
+            {
+                bssSize = (bssSize + alignment - 1) / alignment * alignment;
+            }
+            else
+            {
+                sections[section].resize((sections[section].size() + alignment - 1) / alignment * alignment,
+                                         section == TEXT ? 0x90 : 0);
+            }
+        }
+        else if (name == ".zero")
+        {
+            bssSize += std::stoul(arguments);
+        }
+        else if (name == ".long" || name == ".quad")
+        {
+            size_t size = name == ".long" ? 4 : 8;
+            size_t begin = 0;
+            while (begin < arguments.size())
+            {
+                size_t comma = arguments.find(',', begin);
+                uint64_t value = std::stoull(arguments.substr(begin, comma - begin), nullptr, 0);
+                append(sections[section], value, size);
+                begin = comma == std::string::npos ? arguments.size() : comma + 1;
+            }
+        }
+        else if (name == ".string")
+        {
+            unescape(arguments.substr(1, arguments.size() - 2), sections[section]);
+            sections[section].push_back(0);
+        }
+        else if (name != ".globl" && name != ".type" && name != ".size")
+        {
+            return fail("unknown directive", line);
+        }
+        return true;
+    }
+
+    /**
+     * Bytes of a string written with C escapes
+     */
+    static void unescape(const std::string &text, std::vector<uint8_t> &out)
+    {
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            if (text[i] != '\\' || i + 1 == text.size())
+            {
+                out.push_back((uint8_t)text[i]);
+                continue;
+            }
+            char c = text[++i];
+            if (c >= '0' && c <= '7')
+            {
+                int value = 0;
+                for (int digits = 0; digits < 3 && i < text.size() && text[i] >= '0' && text[i] <= '7'; ++digits)
+                {
+                    value = value * 8 + text[i++] - '0';
+                }
+                --i;
+                out.push_back((uint8_t)value);
+                continue;
+            }
+            static const std::string from = "abfnrtv";
+            static const char to[] = {'\a', '\b', '\f', '\n', '\r', '\t', '\v'};
+            size_t escape = from.find(c);
+            out.push_back((uint8_t)(escape == std::string::npos ? c : to[escape]));
+        }
+    }
+
+    static void append(std::vector<uint8_t> &out, uint64_t value, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            out.push_back((uint8_t)(value >> (8 * i)));
+        }
+    }
+
+    static bool parseOperand(const std::string &text, Operand &operand)
+    {
+        static const char *const registers[] = {"ax", "cx", "dx", "bx", "sp", "bp", "si", "di"};
+        if (text[0] == '$')
+        {
+            operand.kind = Operand::IMMEDIATE;
+            operand.value = std::stoll(text.substr(1));
+            return true;
+        }
+        if (text[0] != '%')
+        {
+            size_t parenthesis = text.find('(');
+            if (parenthesis == std::string::npos)
+            {
+                operand.kind = Operand::LABEL;
+                operand.label = text;
+                return true;
+            }
+            operand.kind = Operand::MEMORY;
+            std::string baseRegister = text.substr(parenthesis);
+            if (baseRegister == "(%rip)")
+            {
+                operand.label = text.substr(0, parenthesis);
+                return true;
+            }
+            operand.value = parenthesis ? std::stoll(text.substr(0, parenthesis)) : 0;
+            return baseRegister == "(%rsp)";
+        }
+        std::string name = text.substr(1);
+        if (name.compare(0, 3, "xmm") == 0)
+        {
+            operand.kind = Operand::XMM;
+            operand.reg = std::stoi(name.substr(3));
+            return true;
+        }
+        operand.kind = Operand::REGISTER;
+        if (name[0] == 'r' && name.size() >= 2 && isdigit((unsigned char)name[1]))
+        {
+            // r8 to r15, and their 32 bit halves r8d to r15d
+            operand.reg = std::stoi(name.substr(1));
+            return true;
+        }
+        for (int r = 0; r < 8; ++r)
+        {
+            std::string low = registers[r];
+            if (name == low.substr(0, 1) + "l" || name == "e" + low || name == "r" + low)
+            {
+                operand.reg = r;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Emits an instruction with a ModRM byte
+     *
+     * @param prefix  mandatory prefix of SSE instructions, 0 if none
+     * @param wide    64 bit operands (REX.W)
+     * @param opcode  bytes of the opcode
+     * @param reg     register or opcode extension of the reg field
+     * @param rm      register or memory operand
+     * @param imm     immediate following the operand
+     * @param immSize bytes of the immediate
+     */
+    void encode(uint8_t prefix, bool wide, std::initializer_list<uint8_t> opcode, int reg, const Operand &rm,
+                int64_t imm = 0, size_t immSize = 0)
+    {
+        std::vector<uint8_t> &code = text();
+        if (prefix)
+        {
+            code.push_back(prefix);
+        }
+        bool registerOperand = rm.kind == Operand::REGISTER || rm.kind == Operand::XMM;
+        uint8_t rex = 0x40 | (wide ? 8 : 0) | (reg >= 8 ? 4 : 0) | (registerOperand && rm.reg >= 8 ? 1 : 0);
+        if (rex != 0x40)
+        {
+            code.push_back(rex);
+        }
+        code.insert(code.end(), opcode.begin(), opcode.end());
+        size_t fixup = 0;
+        if (registerOperand)
+        {
+            code.push_back((uint8_t)(0xC0 | (reg & 7) << 3 | (rm.reg & 7)));
+        }
+        else if (!rm.label.empty())
+        {
+            code.push_back((uint8_t)((reg & 7) << 3 | 5));
+            fixup = code.size();
+            append(code, 0, 4);
+        }
+        else
+        {
+            // based on %rsp, which needs a SIB byte
+            int mod = rm.value == 0 ? 0 : rm.value >= -128 && rm.value < 128 ? 1
+                                                                              : 2;
+            code.push_back((uint8_t)(mod << 6 | (reg & 7) << 3 | 4));
+            code.push_back(0x24);
+            append(code, (uint64_t)rm.value, mod == 0 ? 0 : mod == 1 ? 1
+                                                                   : 4);
+        }
+        append(code, (uint64_t)imm, immSize);
+        if (fixup)
+        {
+            fixups.push_back({fixup, code.size(), rm.label});
+        }
+    }
+
+    void jump(std::initializer_list<uint8_t> opcode, const std::string &label)
+    {
+        std::vector<uint8_t> &code = text();
+        code.insert(code.end(), opcode.begin(), opcode.end());
+        fixups.push_back({code.size(), code.size() + 4, label});
+        append(code, 0, 4);
+    }
+
+    static int condition(const std::string &suffix)
+    {
+        static const char *const names[] = {"o", "no", "b", "ae", "e", "ne", "be", "a",
+                                            "s", "ns", "p", "np", "l", "ge", "le", "g"};
+        for (int c = 0; c < 16; ++c)
+        {
+            if (suffix == names[c])
+            {
+                return c;
+            }
+        }
+        return -1;
+    }
+
+    bool instruction(const std::string &mnemonic, const std::vector<Operand> &operands)
+    {
+        // integer operations: opcode of 'op r/m, reg', of 'op reg, r/m'
+        // and extension of 'op imm, r/m'
+        struct Integer
+        {
+            const char *name;
+            uint8_t load;
+            uint8_t store;
+            int extension;
+        };
+        static const Integer integers[] = {{"add", 0x03, 0x01, 0}, {"or", 0x0B, 0x09, 1}, {"and", 0x23, 0x21, 4}, {"sub", 0x2B, 0x29, 5}, {"xor", 0x33, 0x31, 6}, {"cmp", 0x3B, 0x39, 7}, {"mov", 0x8B, 0x89, -1}};
+        // SSE operations, 'op r/m, xmm': prefix and opcode
+        struct Sse
+        {
+            const char *name;
+            uint8_t prefix;
+            uint8_t opcode;
+        };
+        static const Sse sse[] = {{"movss", 0xF3, 0x10}, {"movsd", 0xF2, 0x10}, {"movaps", 0, 0x28}, {"addss", 0xF3, 0x58}, {"addsd", 0xF2, 0x58}, {"mulss", 0xF3, 0x59}, {"mulsd", 0xF2, 0x59}, {"subss", 0xF3, 0x5C}, {"subsd", 0xF2, 0x5C}, {"divss", 0xF3, 0x5E}, {"divsd", 0xF2, 0x5E}, {"ucomiss", 0, 0x2E}, {"ucomisd", 0x66, 0x2E}, {"xorps", 0, 0x57}, {"cvtsi2ssl", 0xF3, 0x2A}, {"cvtsi2sdl", 0xF2, 0x2A}, {"cvttss2si", 0xF3, 0x2C}, {"cvttsd2si", 0xF2, 0x2C}, {"cvtss2sd", 0xF3, 0x5A}, {"cvtsd2ss", 0xF2, 0x5A}};
+
+        size_t count = operands.size();
+        const Operand *source = count ? &operands[0] : nullptr;
+        const Operand *target = count == 2 ? &operands[1] : source;
+        char size = mnemonic.back();
+        std::string stem = mnemonic.substr(0, mnemonic.size() - 1);
+
+        for (const Sse &op : sse)
+        {
+            if (mnemonic != op.name || count != 2)
+            {
+                continue;
+            }
+            if (target->kind == Operand::MEMORY)
+            {
+                // movss and movsd to memory
+                encode(op.prefix, false, {0x0F, (uint8_t)(op.opcode + 1)}, source->reg, *target);
+            }
+            else
+            {
+                encode(op.prefix, false, {0x0F, op.opcode}, target->reg, *source);
+            }
+            return true;
+        }
+        if ((size == 'l' || size == 'q') && count == 2)
+        {
+            bool wide = size == 'q';
+            for (const Integer &op : integers)
+            {
+                if (stem != op.name)
+                {
+                    continue;
+                }
+                if (source->kind == Operand::IMMEDIATE)
+                {
+                    if (op.extension < 0 && target->kind == Operand::REGISTER && !wide)
+                    {
+                        if (target->reg >= 8)
+                        {
+                            text().push_back(0x41);
+                        }
+                        text().push_back((uint8_t)(0xB8 + (target->reg & 7)));
+                        append(text(), (uint64_t)source->value, 4);
+                    }
+                    else if (op.extension < 0)
+                    {
+                        encode(0, wide, {0xC7}, 0, *target, source->value, 4);
+                    }
+                    else if (source->value >= -128 && source->value < 128)
+                    {
+                        encode(0, wide, {0x83}, op.extension, *target, source->value, 1);
+                    }
+                    else
+                    {
+                        encode(0, wide, {0x81}, op.extension, *target, source->value, 4);
+                    }
+                }
+                else if (target->kind == Operand::MEMORY)
+                {
+                    encode(0, wide, {op.store}, source->reg, *target);
+                }
+                else
+                {
+                    encode(0, wide, {op.load}, target->reg, *source);
+                }
+                return true;
+            }
+        }
+        if (mnemonic == "leaq")
+        {
+            encode(0, true, {0x8D}, target->reg, *source);
+        }
+        else if (mnemonic == "imull")
+        {
+            encode(0, false, {0x0F, 0xAF}, target->reg, *source);
+        }
+        else if (mnemonic == "negl")
+        {
+            encode(0, false, {0xF7}, 3, *source);
+        }
+        else if (mnemonic == "idivl")
+        {
+            encode(0, false, {0xF7}, 7, *source);
+        }
+        else if (mnemonic == "movzbl" || mnemonic == "movsbl")
+        {
+            encode(0, false, {0x0F, (uint8_t)(mnemonic == "movzbl" ? 0xB6 : 0xBE)}, target->reg, *source);
+        }
+        else if (mnemonic == "andb" || mnemonic == "orb")
+        {
+            encode(0, false, {(uint8_t)(mnemonic == "andb" ? 0x20 : 0x08)}, source->reg, *target);
+        }
+        else if (mnemonic.compare(0, 3, "set") == 0 && condition(mnemonic.substr(3)) >= 0)
+        {
+            encode(0, false, {0x0F, (uint8_t)(0x90 + condition(mnemonic.substr(3)))}, 0, *source);
+        }
+        else if (mnemonic == "pushq" || mnemonic == "popq")
+        {
+            if (source->reg >= 8)
+            {
+                text().push_back(0x41);
+            }
+            text().push_back((uint8_t)((mnemonic == "pushq" ? 0x50 : 0x58) + (source->reg & 7)));
+        }
+        else if (mnemonic == "jmp" || mnemonic == "call")
+        {
+            jump({(uint8_t)(mnemonic == "jmp" ? 0xE9 : 0xE8)}, source->label);
+        }
+        else if (mnemonic[0] == 'j' && condition(mnemonic.substr(1)) >= 0)
+        {
+            jump({0x0F, (uint8_t)(0x80 + condition(mnemonic.substr(1)))}, source->label);
+        }
+        else if (mnemonic == "cltd")
+        {
+            text().push_back(0x99);
+        }
+        else if (mnemonic == "ret")
+        {
+            text().push_back(0xC3);
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * Prints the final value of every variable of a program run by
+ * the JIT, one per line as "name = value"
+ *
+ * @param jit     program that was run
+ * @param program it was translated from
+ * @param out     stream to print to
+ */
+inline void printValues(const JitProgram &jit, const IrProgram &program, std::ostream &out)
+{
+    for (const IrVariable &variable : program.getVariables())
+    {
+        const void *global = jit.address("G_" + variable.name);
+        if (!global || variable.value == IrProgram::NO_VALUE || program.at(variable.value).op == Opcode::UNDEF)
+        {
+            continue;
+        }
+        out << variable.name << " = ";
+        switch (variable.type)
+        {
+        case IrType::BOOL:
+            out << (*static_cast<const int32_t *>(global) ? "true" : "false");
+            break;
+        case IrType::CHAR:
+            out << (char)*static_cast<const int32_t *>(global);
+            break;
+        case IrType::FLOAT:
+            out << *static_cast<const float *>(global);
+            break;
+        case IrType::DOUBLE:
+            out << *static_cast<const double *>(global);
+            break;
+        case IrType::STRING:
+            out << *static_cast<const char *const *>(global);
+            break;
+        default:
+            out << *static_cast<const int32_t *>(global);
+            break;
+        }
+        out << "\n";
+    }
+}
+
+#endif // G_JIT_HPP
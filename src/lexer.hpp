@@ -13,7 +13,11 @@
 
 #include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
 #include <vector>
+#include "./context.hpp"
 #include "./utils.hpp"
 
 /**
@@ -101,6 +105,11 @@ struct Token
      * If a token is lexycally valid
      */
     bool isvalid = true;
+
+    /**
+     * Position of the first character of the token in the source code
+     */
+    size_t offset = 0;
 };
 
 /**
@@ -113,9 +122,12 @@ public:
     /**
      * Default constuctor
      *
+     * @param context    of the compilation, receives the errors
      * @param sourcecode string containing the source code
+     * @param firstLine  line where the source code starts
      */
-    Lexer(const std::string &sourcecode) : sourcecode(sourcecode), pos(0) {}
+    Lexer(CompilationContext &context, const std::string &sourcecode, size_t firstLine = 1)
+        : sourcecode(sourcecode), pos(0), firstLine(firstLine), context(context) {}
 
     /**
      * Lexycal analyzer
@@ -124,10 +136,12 @@ public:
      */
     std::vector<Token> lex()
     {
-        line = 1;
+        line = firstLine;
         while (pos < sourcecode.size())
         {
             current_char = sourcecode[pos];
+            size_t start = pos;
+            size_t count = tokens.size();
 
             if (isSkippable(current_char))
             {
@@ -146,23 +160,26 @@ public:
             if (isalpha(current_char))
             {
                 identifierOrKeyword();
-                continue;
             }
-
             // Recognize int literals (see G-Programming-Language\docs\regex.txt)
-            if (isdigit(current_char))
+            else if (isdigit(current_char))
             {
                 numberLiteral();
-                continue;
             }
-
             // Recognize symbols (see G-Programming-Language\docs\regex.txt)
-            operators();
+            else
+            {
+                operators();
+                pos++;
+            }
 
-            pos++;
+            for (size_t i = count; i < tokens.size(); ++i)
+            {
+                tokens[i].offset = start;
+            }
         }
 
-        tokens.push_back({TokenType::_EOF, "_EOF", line});
+        tokens.push_back({TokenType::_EOF, "_EOF", line, true, sourcecode.size()});
         return tokens;
     }
 
@@ -195,6 +212,11 @@ private:
      */
     size_t line;
 
+    /**
+     * Line where the source code starts
+     */
+    size_t firstLine = 1;
+
     /**
      * Current char
      */
@@ -206,9 +228,9 @@ private:
     bool valid = true;
 
     /**
-     * Unabled constructor
+     * Compilation the source code belongs to
      */
-    Lexer() {}
+    CompilationContext &context;
 
     /**
      * Consumes a char from the stream
@@ -261,7 +283,7 @@ private:
                 std::stringstream error;
                 error << "Too long name for identifier at line ";
                 error << line << ". It can't be more than 32 characters long.";
-                errorMessage(error.str());
+                context.error(error.str());
                 unvalidate();
             }
 
@@ -333,6 +355,7 @@ private:
      */
     void numberLiteral()
     {
+        size_t line = this->line;
         std::stringstream ss;
         while (isdigit(sourcecode[pos]))
         {
@@ -353,6 +376,10 @@ private:
 
         while (isSkippable(sourcecode[pos]) || isNewLine(sourcecode[pos]))
         {
+            if (isNewLine(sourcecode[pos]))
+            {
+                this->line++;
+            }
             pos++;
         }
 
@@ -366,7 +393,7 @@ private:
                 error << "Invalid float literal at line ";
                 error << line << ". Token found: '" << s << "'. ";
                 error << "A digit was expected after '.' character.";
-                errorMessage(error.str());
+                context.error(error.str());
                 unvalidate();
             }
             else if (is_float)
@@ -382,6 +409,10 @@ private:
         {
             while (!isNumberLiteralEnd(sourcecode[pos]) && pos < sourcecode.size())
             {
+                if (isNewLine(sourcecode[pos]))
+                {
+                    this->line++;
+                }
                 ss << sourcecode[pos++];
             }
 
@@ -450,6 +481,10 @@ private:
         {
             minusOperator();
         }
+        else if (current_char == '^')
+        {
+            tokens.push_back({TokenType::XOR_LOGIC, "^", line});
+        }
         else if (current_char == '*')
         {
             tokens.push_back({TokenType::MULTIPLY, "*", line});
@@ -504,7 +539,7 @@ private:
                 error << "Invalid character literal at line ";
                 error << line << ". Token found: '" << token_value << "'. ";
                 error << "A char literal has to be 1 character long.";
-                errorMessage(error.str());
+                context.error(error.str());
                 unvalidate();
             }
 
@@ -514,7 +549,7 @@ private:
                 error << "Invalid character literal at line ";
                 error << line << ". Token found: '" << token_value << "'. ";
                 error << "Escape characters: \\<char>.";
-                errorMessage(error.str());
+                context.error(error.str());
                 unvalidate();
             }
 
@@ -534,7 +569,7 @@ private:
                 error << "Invalid character literal at line ";
                 error << line << ". Token found: '" << token_value << "'. ";
                 error << "Escape characters: \\<char>.";
-                errorMessage(error.str());
+                context.error(error.str());
                 unvalidate();
             }
 
@@ -545,7 +580,7 @@ private:
             std::stringstream ss;
             ss << "Invalid character '" << current_char;
             ss << "' at line " << line << ".";
-            errorMessage(ss.str());
+            context.error(ss.str());
             ss.clear();
             ss << current_char;
             tokens.push_back({TokenType::UNDEFINED, ss.str(), line, false});
@@ -565,7 +600,7 @@ private:
         std::stringstream ss;
         bool error = false;
         size_t backslash = 0;
-        while (sourcecode[pos] != ch)
+        while (sourcecode[pos] != ch && pos < sourcecode.size())
         {
             if (sourcecode[pos] == '\\')
             {
@@ -661,6 +696,10 @@ private:
             }
             else
             {
+                if (isNewLine(sourcecode[pos]))
+                {
+                    line++;
+                }
                 ss << sourcecode[pos++];
             }
         }
@@ -683,6 +722,8 @@ private:
             {
                 ss << sourcecode[pos++];
             }
+            // the '\n' is left to lex() so that it is counted
+            pos--;
             // tokens.push_back({TokenType::SINGLE_LINE_COMMENT, ss.str(), line});
         }
         else if (sourcecode[pos + 1] == '*')
@@ -691,13 +732,18 @@ private:
             std::stringstream ss;
             while (!(sourcecode[pos] == '*' && sourcecode[pos + 1] == '/') && pos < size)
             {
+                if (isNewLine(sourcecode[pos]))
+                {
+                    line++;
+                }
                 ss << sourcecode[pos++];
             }
 
+            // lex() moves past the closing '/'
             if (pos < size)
             {
                 ss << sourcecode[pos++];
-                ss << sourcecode[pos++];
+                ss << sourcecode[pos];
             }
             // tokens.push_back({TokenType::MULTI_LINE_COMMENT, ss.str(), line});
         }
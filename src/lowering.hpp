@@ -0,0 +1,304 @@
+/**
+ * @file    G-Programming-Language/Compiler/lowering.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_LOWERING_HPP
+#define G_LOWERING_HPP
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./interner.hpp"
+#include "./ir.hpp"
+#include "./parser_new.hpp"
+#include "./symbols.hpp"
+
+/**
+ * Translates a parse tree to SSA form. Expressions have no
+ * side effects and there are no loops, so a variable is just
+ * the value of its last store and no phi is ever needed for
+ * variables: phis only join the two ways out of '&&' and '||'.
+ * Implicit C++ conversions become CONVERT instructions.
+ */
+class IrBuilder
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param symbols of the program
+     */
+    explicit IrBuilder(const FrozenSymbolTable &symbols) : symbols(symbols), program(symbols.getStrings()) {}
+
+    /**
+     * Lowers a program
+     *
+     * @param tree root of a valid parse tree
+     * @return the program in SSA form
+     */
+    IrProgram build(const std::shared_ptr<ParseTreeNode> &tree)
+    {
+        block = program.addBlock();
+        auto root = std::static_pointer_cast<NonTerminalNode>(tree);
+        for (const auto &child : root->getChildren())
+        {
+            auto statement = std::static_pointer_cast<NonTerminalNode>(child);
+            auto node = std::static_pointer_cast<NonTerminalNode>(statement->getChildren().at(0));
+            if (node->getLabel() == "declaration")
+            {
+                node = std::static_pointer_cast<NonTerminalNode>(node->getChildren().at(0));
+                std::string name = node->getValue(1);
+                IrType type = irTypeOf(symbols.typeOf(name));
+                uint32_t id = names.intern(name);
+                if (id >= values.size())
+                {
+                    values.resize(id + 1, (uint32_t)IrProgram::NO_VALUE);
+                    types.resize(id + 1, IrType::VOID);
+                }
+                types[id] = type;
+                values[id] = node->getChildren().size() == 3 ? store(node->getChildren()[2], type)
+                                                             : emit(Opcode::UNDEF, type);
+            }
+            else
+            {
+                uint32_t id = names.intern(node->getValue(0));
+                values[id] = store(node->getChildren().at(1), types[id]);
+            }
+        }
+        emit(Opcode::RET, IrType::VOID);
+
+        for (uint32_t id = 0; id < names.size(); ++id)
+        {
+            program.addVariable(names.getString(id), types[id], values[id]);
+        }
+        return std::move(program);
+    }
+
+private:
+    const FrozenSymbolTable &symbols;
+
+    IrProgram program;
+
+    /**
+     * Block instructions are appended to
+     */
+    uint32_t block = 0;
+
+    /**
+     * Line of the statement being lowered
+     */
+    uint32_t line = 0;
+
+    /**
+     * Variables by id, and their type and current value
+     */
+    StringInterner names;
+    std::vector<IrType> types;
+    std::vector<uint32_t> values;
+
+    uint32_t emit(Opcode op, IrType type, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0, ConstValue constant = ConstValue())
+    {
+        return program.append(block, {op, type, line, {a, b, c}, constant});
+    }
+
+    uint32_t constant(IrType type, ConstValue value)
+    {
+        return emit(Opcode::CONST, type, 0, 0, 0, value);
+    }
+
+    /**
+     * Value converted to a type, as C++ does implicitly
+     */
+    uint32_t convert(uint32_t value, IrType type)
+    {
+        if (program.at(value).type == type)
+        {
+            return value;
+        }
+        return emit(Opcode::CONVERT, type, value);
+    }
+
+    /**
+     * Lowers the expression stored in a variable
+     *
+     * @param expression node of the statement
+     * @param type       of the variable
+     * @return value stored
+     */
+    uint32_t store(const std::shared_ptr<ParseTreeNode> &expression, IrType type)
+    {
+        const auto &root = static_cast<NonTerminalNode &>(*expression).getChildren().at(0);
+        auto terminal = dynamic_cast<TerminalNode *>(root.get());
+        if (terminal && terminal->getType() == TokenType::NULL_KEYWORD)
+        {
+            // the value initialised type
+            return zeroOf(type);
+        }
+        return convert(lower(root), type);
+    }
+
+    uint32_t zeroOf(IrType type)
+    {
+        switch (type)
+        {
+        case IrType::STRING:
+            return constant(type, ConstValue::ofString(program.getStrings().intern("")));
+        case IrType::FLOAT:
+        case IrType::DOUBLE:
+            return constant(type, ConstValue::ofFloat(0));
+        default:
+            return constant(type, ConstValue::ofInt(0));
+        }
+    }
+
+    uint32_t lower(const std::shared_ptr<ParseTreeNode> &node)
+    {
+        // raw casts: no reference count to touch for every node
+        if (auto terminal = dynamic_cast<TerminalNode *>(node.get()))
+        {
+            return lowerTerminal(*terminal);
+        }
+        if (auto unary = dynamic_cast<UnaryNode *>(node.get()))
+        {
+            line = (uint32_t)unary->getLine();
+            uint32_t operand = lower(unary->getOperand());
+            if (unary->getOperator() == TokenType::NOT_LOGIC)
+            {
+                return emit(Opcode::NOT, IrType::BOOL, convert(operand, IrType::BOOL));
+            }
+            IrType type = promote(program.at(operand).type);
+            return emit(Opcode::NEG, type, convert(operand, type));
+        }
+        auto binary = static_cast<BinaryNode *>(node.get());
+        TokenType op = binary->getOperator();
+        if (op == TokenType::AND_CONDITIONAL || op == TokenType::OR_CONDITIONAL)
+        {
+            return lowerConditional(*binary);
+        }
+
+        uint32_t lhs = lower(binary->getLhs());
+        uint32_t rhs = lower(binary->getRhs());
+        line = (uint32_t)binary->getLine();
+        IrType type = commonType(promote(program.at(lhs).type), promote(program.at(rhs).type));
+        lhs = convert(lhs, type);
+        rhs = convert(rhs, type);
+        Opcode opcode = opcodeOf(op);
+        return emit(opcode, isComparison(opcode) ? IrType::BOOL : type, lhs, rhs);
+    }
+
+    /**
+     * '&&' and '||' evaluate their right operand only when the
+     * left one does not decide the result:
+     *
+     *     entry: l = ...; cbr l, right, join    (swapped for '||')
+     *     right: r = ...; br join
+     *     join:  phi [l, entry], [r, right]
+     */
+    uint32_t lowerConditional(const BinaryNode &binary)
+    {
+        bool isAnd = binary.getOperator() == TokenType::AND_CONDITIONAL;
+        uint32_t lhs = convert(lower(binary.getLhs()), IrType::BOOL);
+        line = (uint32_t)binary.getLine();
+        uint32_t entry = block;
+        uint32_t right = program.addBlock();
+        uint32_t join = program.addBlock();
+        emit(Opcode::CBR, IrType::VOID, lhs, isAnd ? right : join, isAnd ? join : right);
+
+        block = right;
+        uint32_t rhs = convert(lower(binary.getRhs()), IrType::BOOL);
+        uint32_t rightEnd = block;
+        emit(Opcode::BR, IrType::VOID, join);
+
+        block = join;
+        return program.appendPhi(join, IrType::BOOL, {{entry, lhs}, {rightEnd, rhs}}, line);
+    }
+
+    uint32_t lowerTerminal(TerminalNode &terminal)
+    {
+        const std::string value = terminal.getValue();
+        line = (uint32_t)terminal.getLine();
+        switch (terminal.getType())
+        {
+        case TokenType::TRUE:
+            return constant(IrType::BOOL, ConstValue::ofInt(1));
+        case TokenType::FALSE:
+            return constant(IrType::BOOL, ConstValue::ofInt(0));
+        case TokenType::INT_LITERAL:
+        {
+            ConstValue v = intValue(value);
+            return constant(IrType::INT, v.isConstant() ? v : ConstValue::ofInt(0));
+        }
+        case TokenType::FLOAT_LITERAL:
+            return constant(IrType::DOUBLE, ConstValue::ofFloat(std::strtod(value.c_str(), nullptr)));
+        case TokenType::CHAR_LITERAL:
+        {
+            ConstValue v = charValue(value);
+            return constant(IrType::CHAR, v.isConstant() ? v : ConstValue::ofInt(0));
+        }
+        case TokenType::STRING_LITERAL:
+            return constant(IrType::STRING, ConstValue::ofString(program.getStrings().intern(value)));
+        case TokenType::IDENTIFIER:
+            return values[names.find(value)];
+        default:
+            // NULL inside an expression is the integer 0
+            return constant(IrType::INT, ConstValue::ofInt(0));
+        }
+    }
+
+    static Opcode opcodeOf(TokenType op)
+    {
+        switch (op)
+        {
+        case TokenType::PLUS:
+            return Opcode::ADD;
+        case TokenType::MINUS:
+            return Opcode::SUB;
+        case TokenType::MULTIPLY:
+            return Opcode::MUL;
+        case TokenType::DIVIDE:
+            return Opcode::DIV;
+        case TokenType::MODULO:
+            return Opcode::MOD;
+        case TokenType::AND_LOGIC:
+            return Opcode::AND;
+        case TokenType::OR_LOGIC:
+            return Opcode::OR;
+        case TokenType::XOR_LOGIC:
+            return Opcode::XOR;
+        case TokenType::EQUAL:
+            return Opcode::EQ;
+        case TokenType::NOT_EQUAL:
+            return Opcode::NE;
+        case TokenType::LOWER:
+            return Opcode::LT;
+        case TokenType::LOWER_EQUAL:
+            return Opcode::LE;
+        case TokenType::GREATER:
+            return Opcode::GT;
+        default:
+            return Opcode::GE;
+        }
+    }
+};
+
+/**
+ * Lowers a parse tree to SSA form
+ *
+ * @param tree    root of a valid parse tree
+ * @param symbols of the program
+ * @return the program in SSA form
+ */
+inline IrProgram lower(const std::shared_ptr<ParseTreeNode> &tree, const FrozenSymbolTable &symbols)
+{
+    return IrBuilder(symbols).build(tree);
+}
+
+#endif // G_LOWERING_HPP
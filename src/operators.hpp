@@ -0,0 +1,98 @@
+/**
+ * @file    G-Programming-Language/Compiler/operators.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_OPERATORS_HPP
+#define G_OPERATORS_HPP
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "./lexer.hpp"
+
+/**
+ * Binding power of prefix operators, higher than any binary one
+ */
+constexpr int UNARY_PRECEDENCE = 10;
+
+/**
+ * Binding power of operands (literals, identifiers)
+ */
+constexpr int PRIMARY_PRECEDENCE = 11;
+
+/**
+ * Binding power of every token, 0 if it is not a binary operator.
+ * Same levels as C/C++, so the generated code needs no extra parentheses.
+ */
+struct PrecedenceTable
+{
+    uint8_t binary[(int)TokenType::_EOF + 1];
+};
+
+/**
+ * Builds the precedence table
+ *
+ * @return table indexed by token type
+ */
+constexpr PrecedenceTable makePrecedenceTable()
+{
+    PrecedenceTable table{};
+    table.binary[(int)TokenType::OR_CONDITIONAL] = 1;
+    table.binary[(int)TokenType::AND_CONDITIONAL] = 2;
+    table.binary[(int)TokenType::OR_LOGIC] = 3;
+    table.binary[(int)TokenType::XOR_LOGIC] = 4;
+    table.binary[(int)TokenType::AND_LOGIC] = 5;
+    table.binary[(int)TokenType::EQUAL] = 6;
+    table.binary[(int)TokenType::NOT_EQUAL] = 6;
+    table.binary[(int)TokenType::LOWER] = 7;
+    table.binary[(int)TokenType::LOWER_EQUAL] = 7;
+    table.binary[(int)TokenType::GREATER] = 7;
+    table.binary[(int)TokenType::GREATER_EQUAL] = 7;
+    table.binary[(int)TokenType::PLUS] = 8;
+    table.binary[(int)TokenType::MINUS] = 8;
+    table.binary[(int)TokenType::MULTIPLY] = 9;
+    table.binary[(int)TokenType::DIVIDE] = 9;
+    table.binary[(int)TokenType::MODULO] = 9;
+    return table;
+}
+
+constexpr PrecedenceTable PRECEDENCE = makePrecedenceTable();
+
+/**
+ * Binding power of a binary operator
+ *
+ * @param type of the token
+ * @return precedence, 0 if the token is not a binary operator
+ */
+constexpr int binaryPrecedence(TokenType type)
+{
+    return PRECEDENCE.binary[(int)type];
+}
+
+static_assert(binaryPrecedence(TokenType::MULTIPLY) > binaryPrecedence(TokenType::PLUS), "'*' binds tighter than '+'");
+static_assert(binaryPrecedence(TokenType::SEMICOLON) == 0, "';' is not an operator");
+
+/**
+ * Wraps an operand in parentheses when it binds looser than
+ * the operator it belongs to
+ *
+ * @param code       of the operand
+ * @param precedence of the operand
+ * @param min        lowest precedence allowed without parentheses
+ * @return the operand, parenthesised if needed
+ */
+inline std::string parenthesise(const std::string &code, int precedence, int min)
+{
+    if (precedence < min)
+    {
+        return "(" + code + ")";
+    }
+    return code;
+}
+
+#endif // G_OPERATORS_HPP
@@ -11,17 +11,21 @@
 #define G_PARSER_HPP
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
 #include <sstream>
-#include <unordered_map>
+#include <thread>
+#include "./arena.hpp"
+#include "./context.hpp"
+#include "./emit.hpp"
+#include "./flat_ast.hpp"
+#include "./grammar.hpp"
+#include "./interner.hpp"
 #include "./lexer.hpp"
-
-bool symbolTableOk = true;
-
-void symTableError()
-{
-    symbolTableOk = false;
-}
+#include "./operators.hpp"
+#include "./symbols.hpp"
 
 /**
  * Convert token type to string
@@ -29,7 +33,7 @@ void symTableError()
  * @param type of token
  * @return token name
  */
-std::string convertToken(TokenType type)
+inline std::string convertToken(TokenType type)
 {
     if (type == TokenType::FALSE)
     {
@@ -95,6 +99,14 @@ std::string convertToken(TokenType type)
     {
         return "!=";
     }
+    else if (type == TokenType::GREATER)
+    {
+        return ">";
+    }
+    else if (type == TokenType::LOWER)
+    {
+        return "<";
+    }
     else if (type == TokenType::GREATER_EQUAL)
     {
         return ">=";
@@ -202,100 +214,447 @@ std::string convertToken(TokenType type)
     return "invalid token";
 }
 
-enum class SymbolType
-{
-    BOOLEAN = (int)TokenType::BOOLEAN_KEYWORD,
-    INT,
-    FLOAT,
-    CHAR,
-    STRING,
-    UNDEFINED = (int)TokenType::UNDEFINED
-};
-
 class Symbol
 {
 public:
     SymbolType type;
-    std::string name;
-    std::string value;
+    /**
+     * Interned name, see SymbolTable::getName()
+     */
+    uint32_t name;
+    /**
+     * Value after the last assignment
+     */
+    ConstValue value;
     int line;
+    /**
+     * Symbol with the same name hidden by this one, NO_SYMBOL if none
+     */
+    uint32_t shadowed;
+    /**
+     * If the symbol is assigned after its declaration
+     */
+    bool reassigned = false;
 };
 
+/**
+ * Scoped symbol table. Names are interned once, so every
+ * operation costs a single hash probe plus array accesses:
+ * 'bindings' maps a name id to its innermost symbol.
+ * Symbols are kept in declaration order, the innermost scope
+ * last: closing a scope walks its symbols backwards and
+ * restores the bindings they shadowed, like an undo log.
+ */
 class SymbolTable
 {
 public:
-    void addSymbol(SymbolType type, const std::string name, int line, const std::string value = "NULL")
+    static const uint32_t NO_SYMBOL = UINT32_MAX;
+
+    /**
+     * Default constructor
+     *
+     * @param context of the compilation, receives the errors
+     */
+    explicit SymbolTable(CompilationContext &context) : context(&context) {}
+
+    void addSymbol(SymbolType type, const std::string &name, int line, ConstValue value = ConstValue())
     {
-        auto it = symbols.find(name);
-        if (it != symbols.end())
+        uint32_t id = names.intern(name);
+        if (id >= bindings.size())
+        {
+            bindings.resize(id + 1, (uint32_t)NO_SYMBOL);
+        }
+        uint32_t previous = bindings[id];
+        if (previous != NO_SYMBOL && previous >= scopeBegin())
         {
             std::stringstream ss;
             ss << "Variable '" << name << "' already declared on line ";
-            ss << it->second.line << ".";
-            errorMessage(ss.str());
-            symTableError();
+            ss << symbols[previous].line << ".";
+            context->error(ss.str());
+            context->symbolTableError();
         }
         else
         {
-            symbols[name] = {type, name, value, line};
+            bindings[id] = (uint32_t)symbols.size();
+            symbols.push_back({type, id, value, line, previous});
+        }
+    }
+
+    /**
+     * Removes a symbol declared in the current scope
+     *
+     * @param name of the symbol
+     */
+    void removeSymbol(const std::string &name)
+    {
+        uint32_t index = find(name);
+        if (index == NO_SYMBOL || index < scopeBegin())
+        {
+            return;
+        }
+        bindings[symbols[index].name] = symbols[index].shadowed;
+        // the order inside a scope does not matter: the last
+        // symbol fills the hole
+        if (index != symbols.size() - 1)
+        {
+            symbols[index] = std::move(symbols.back());
+            bindings[symbols[index].name] = index;
+        }
+        symbols.pop_back();
+    }
+
+    void setLine(const std::string &name, int line)
+    {
+        uint32_t index = find(name);
+        if (index != NO_SYMBOL)
+        {
+            symbols[index].line = line;
         }
     }
 
-    const Symbol &lookupSymbol(const std::string name) const
+    bool isDeclared(const std::string &name) const
     {
-        auto it = symbols.find(name);
-        if (it == symbols.end())
+        return find(name) != NO_SYMBOL;
+    }
+
+    const Symbol &lookupSymbol(const std::string &name) const
+    {
+        static const Symbol undefined = {SymbolType::UNDEFINED, StringInterner::NO_ID, ConstValue(), 0, NO_SYMBOL};
+        uint32_t index = find(name);
+        if (index == NO_SYMBOL)
         {
             std::stringstream ss;
             ss << "Variable " << name << " not found.";
-            errorMessage(ss.str());
-            symTableError();
+            context->error(ss.str());
+            context->symbolTableError();
+            return undefined;
         }
-        return it->second;
+        return symbols[index];
     }
 
-    void setValue(const std::string name, const std::string value, const int line)
+    void setValue(const std::string &name, ConstValue value, const int line)
     {
-        auto it = symbols.find(name);
-        if (it != symbols.end())
+        uint32_t index = find(name);
+        if (index != NO_SYMBOL)
         {
-            symbols[name].value = value;
+            symbols[index].value = value;
+            symbols[index].reassigned = true;
         }
         else
         {
             std::stringstream ss;
             ss << "Undeclared variable '" << name << "' was used ";
             ss << "on line " << line << ".";
-            errorMessage(ss.str());
-            symTableError();
+            context->error(ss.str());
+            context->symbolTableError();
+        }
+    }
+
+    /**
+     * Type of the innermost symbol with a name
+     *
+     * @param name of the symbol
+     * @return its type, UNDEFINED if there is none
+     */
+    SymbolType typeOf(const std::string &name) const
+    {
+        uint32_t index = find(name);
+        return index == NO_SYMBOL ? SymbolType::UNDEFINED : symbols[index].type;
+    }
+
+    /**
+     * Value of a literal stored in a symbol
+     *
+     * @param literal type of the literal token, UNDEFINED for an
+     *                expression that is not a literal, _EOF when
+     *                nothing is stored
+     * @param text    of the literal, '-' in front if negated
+     * @param target  type of the symbol
+     * @return the value
+     */
+    ConstValue literal(TokenType literal, const std::string &text, SymbolType target)
+    {
+        switch (literal)
+        {
+        case TokenType::_EOF:
+            return ConstValue();
+        case TokenType::TRUE:
+            return ConstValue::ofInt(1);
+        case TokenType::FALSE:
+            return ConstValue::ofInt(0);
+        case TokenType::INT_LITERAL:
+            return intValue(text);
+        case TokenType::FLOAT_LITERAL:
+            return ConstValue::ofFloat(std::strtod(text.c_str(), nullptr));
+        case TokenType::CHAR_LITERAL:
+            return charValue(text);
+        case TokenType::STRING_LITERAL:
+            return ConstValue::ofString(constants.intern(text));
+        case TokenType::NULL_KEYWORD:
+            // NULL is the value initialised type of the symbol
+            if (target == SymbolType::STRING)
+            {
+                return ConstValue::ofString(constants.intern(""));
+            }
+            else if (target == SymbolType::FLOAT)
+            {
+                return ConstValue::ofFloat(0);
+            }
+            else if (target != SymbolType::UNDEFINED)
+            {
+                return ConstValue::ofInt(0);
+            }
+            return ConstValue::nonConstant();
+        default:
+            return ConstValue::nonConstant();
         }
     }
 
-    void print()
+    /**
+     * Opens a scope: symbols declared from now on may shadow
+     * the ones of the enclosing scopes
+     */
+    void pushScope()
     {
-        for (auto it = symbols.begin(); it != symbols.end(); ++it)
+        scopes.push_back((uint32_t)symbols.size());
+    }
+
+    /**
+     * Closes the innermost scope, dropping its symbols
+     */
+    void popScope()
+    {
+        if (scopes.empty())
         {
-            std::cout << "Variable: type:  " << convertToken((TokenType)((int)it->second.type)) << "\n";
-            std::cout << "          name:  " << it->second.name << "\n";
-            std::cout << "          value: " << it->second.value << "\n";
-            std::cout << "          line:  " << it->second.line << "\n";
+            return;
+        }
+        for (size_t i = symbols.size(); i-- > scopes.back();)
+        {
+            bindings[symbols[i].name] = symbols[i].shadowed;
+        }
+        symbols.resize(scopes.back());
+        scopes.pop_back();
+    }
+
+    /**
+     * Number of scopes open, 0 for the global one
+     */
+    size_t getScopeDepth() const
+    {
+        return scopes.size();
+    }
+
+    const std::string &getName(const Symbol &symbol) const
+    {
+        return names.getString(symbol.name);
+    }
+
+    CompilationContext &getContext() const
+    {
+        return *context;
+    }
+
+    /**
+     * Copies the visible symbols in a read only table
+     *
+     * @return the frozen table
+     */
+    std::shared_ptr<const FrozenSymbolTable> freeze() const
+    {
+        std::vector<FrozenSymbol> visible;
+        visible.reserve(symbols.size());
+        for (size_t i = 0; i < symbols.size(); ++i)
+        {
+            const Symbol &symbol = symbols[i];
+            if (bindings[symbol.name] == i)
+            {
+                visible.push_back({getName(symbol), symbol.type, symbol.value, symbol.line, 0, symbol.reassigned});
+            }
+        }
+        return std::make_shared<const FrozenSymbolTable>(std::move(visible), constants);
+    }
+
+    void print(std::ostream &out = std::cout) const
+    {
+        for (const Symbol &symbol : symbols)
+        {
+            out << "Variable: type:  " << convertToken((TokenType)((int)symbol.type)) << "\n";
+            out << "          name:  " << getName(symbol) << "\n";
+            out << "          value: " << describe(symbol.value, constants) << "\n";
+            out << "          line:  " << symbol.line << "\n";
         }
     }
 
 private:
-    std::unordered_map<std::string, Symbol> symbols;
+    /**
+     * Compilation the symbols belong to
+     */
+    CompilationContext *context;
+
+    /**
+     * Names of the symbols
+     */
+    StringInterner names;
+
+    /**
+     * String constants held by the symbols
+     */
+    StringInterner constants;
+
+    /**
+     * Innermost symbol of every name id, NO_SYMBOL if none
+     */
+    std::vector<uint32_t> bindings;
+
+    /**
+     * Visible and shadowed symbols, in declaration order
+     */
+    std::vector<Symbol> symbols;
+
+    /**
+     * Index in 'symbols' of the first symbol of every open scope
+     */
+    std::vector<uint32_t> scopes;
+
+    /**
+     * Index of the first symbol of the current scope
+     */
+    uint32_t scopeBegin() const
+    {
+        return scopes.empty() ? 0 : scopes.back();
+    }
+
+    /**
+     * Innermost symbol with a name
+     *
+     * @param name of the symbol
+     * @return index in 'symbols', NO_SYMBOL if there is none
+     */
+    uint32_t find(const std::string &name) const
+    {
+        uint32_t id = names.find(name);
+        if (id == StringInterner::NO_ID || id >= bindings.size())
+        {
+            return NO_SYMBOL;
+        }
+        return bindings[id];
+    }
 };
 
 class ParseTreeNode
 {
 public:
     virtual ~ParseTreeNode() = default;
-    virtual std::string generateCode(int indentation = 1) const = 0;
+
+    /**
+     * C++ code of the node
+     *
+     * @param symbols     of the program
+     * @param indentation of the statements, in tabs
+     * @return the code
+     */
+    std::string generateCode(const FrozenSymbolTable &symbols, int indentation = 1) const
+    {
+        CodeBuffer code;
+        emitCode(code, symbols, indentation);
+        return std::move(code.text);
+    }
+
+    /**
+     * Appends the C++ code of the node. The whole program is
+     * emitted into one buffer, so every byte is written once
+     * whatever the depth of the tree.
+     *
+     * @param code        buffer the code is appended to
+     * @param symbols     of the program
+     * @param indentation of the statements, in tabs
+     */
+    virtual void emitCode(CodeBuffer &code, const FrozenSymbolTable &symbols, int indentation = 1) const = 0;
     virtual std::string getValue()
     {
         return "";
     }
     virtual void print(int depth = 0) const = 0;
+    virtual void flatten(FlatAst &ast) const = 0;
+    virtual int getPrecedence() const
+    {
+        return PRIMARY_PRECEDENCE;
+    }
+
+    /**
+     * Appends the names of the variables read by this node
+     *
+     * @param names where the names are appended, once per read
+     */
+    virtual void collectReads(std::vector<std::string> &) const {}
+
+    /**
+     * Checks if the node is a literal, negated or not
+     */
+    virtual bool isLiteral() const
+    {
+        return false;
+    }
+
+    /**
+     * Checks if the node is NULL alone, not negated nor in an operation
+     */
+    virtual bool isNull() const
+    {
+        return false;
+    }
+
+    /**
+     * Checks if evaluating the node may stop the program, with a
+     * division by zero or an overflowing division
+     */
+    virtual bool mayTrap() const
+    {
+        return false;
+    }
+
+    /**
+     * Checks if the node is a constant no division by it can stop
+     * the program: not 0 and not -1
+     */
+    virtual bool isSafeDivisor() const
+    {
+        return false;
+    }
+
+protected:
+    /**
+     * Appends the code of an operand, parenthesised if it binds
+     * less tightly than 'min'
+     */
+    static void emitOperand(CodeBuffer &code, const ParseTreeNode &operand, const FrozenSymbolTable &symbols, int min)
+    {
+        bool parenthesised = operand.getPrecedence() < min;
+        if (parenthesised)
+        {
+            code.text += '(';
+        }
+        operand.emitCode(code, symbols, 0);
+        if (parenthesised)
+        {
+            code.text += ')';
+        }
+    }
+
+    /**
+     * Appends a value stored in a variable: a bare NULL becomes
+     * the value initialised type of the variable
+     */
+    static void emitValue(CodeBuffer &code, const ParseTreeNode &value, SymbolType type, const FrozenSymbolTable &symbols)
+    {
+        if (type != SymbolType::UNDEFINED && value.isNull())
+        {
+            code.text += cppType(type);
+            code.text += "{}";
+            return;
+        }
+        value.emitCode(code, symbols);
+    }
 };
 
 class NonTerminalNode : public ParseTreeNode
@@ -308,61 +667,104 @@ public:
         children.push_back(child);
     }
 
-    std::string generateCode(const int indentation = 1) const override
+    /**
+     * Replaces 'count' children starting from 'first'
+     *
+     * @param first    index of the first child replaced
+     * @param count    number of children replaced
+     * @param children new children
+     */
+    void replaceChildren(size_t first, size_t count, const std::vector<std::shared_ptr<ParseTreeNode>> &children)
+    {
+        auto begin = this->children.begin() + first;
+        size_t common = std::min(count, children.size());
+        std::copy(children.begin(), children.begin() + common, begin);
+        if (count > common)
+        {
+            this->children.erase(begin + common, begin + count);
+        }
+        else
+        {
+            this->children.insert(begin + common, children.begin() + common, children.end());
+        }
+    }
+
+    const std::vector<std::shared_ptr<ParseTreeNode>> &getChildren() const
+    {
+        return children;
+    }
+
+    const std::string &getLabel() const
+    {
+        return label;
+    }
+
+    void emitCode(CodeBuffer &code, const FrozenSymbolTable &symbols, const int indentation = 1) const override
     {
-        std::string indent = std::string(indentation, '\t');
-        std::stringstream code;
         if (label == "program")
         {
-            code << "#include<iostream>\n";
-            code << "int main(int argc, char* argv[])\n{\n";
+            // the headers come from CodeGenerator, after the body
+            code.text += "int main(int argc, char* argv[])\n{\n";
             for (const auto &child : children)
             {
-                code << child->generateCode();
+                child->emitCode(code, symbols);
             }
-            code << "\treturn 0;\n}";
+            code.text += "\treturn 0;\n}";
         }
         else if (label == "statement")
         {
-            code << children.at(0)->generateCode();
+            children.at(0)->emitCode(code, symbols);
         }
         else if (label == "declaration")
         {
             // only one child
-            code << children.at(0)->generateCode();
-            code << ";\n";
+            children.at(0)->emitCode(code, symbols);
+            code.text += ";\n";
         }
         else if (label == "id_declaration")
         {
-            code << indent << children.at(0)->getValue() << " " << children.at(1)->getValue();
+            // the type comes from the symbol table, not from the keyword
+            std::string name = children.at(1)->getValue();
+            const FrozenSymbol *symbol = symbols.find(name);
+            code.text.append(indentation, '\t');
+            // the qualifier depends on the value, known from its node before anything is emitted
+            if (children.size() == 3)
+            {
+                const std::shared_ptr<ParseTreeNode> &value = children.at(2);
+                code.text += declarationQualifier(symbol, value->isLiteral(), [&value] { return value->getValue(); });
+            }
+            code.text += FrozenSymbolTable::cppTypeOf(symbol);
+            code.text += ' ';
+            code.text += name;
             // there is an assignment
             if (children.size() == 3)
             {
-                code << " = ";
-                code << children.at(2)->generateCode();
+                code.text += " = ";
+                emitValue(code, *children.at(2), symbol ? symbol->type : SymbolType::UNDEFINED, symbols);
             }
         }
         else if (label == "assignment")
         {
             // identifier
-            code << indent << children.at(0)->generateCode();
-            code << " = ";
+            std::string name = children.at(0)->getValue();
+            code.text.append(indentation, '\t');
+            code.text += name;
+            code.text += " = ";
             // whole expression
-            code << children.at(1)->generateCode();
-            code << ";\n";
+            emitValue(code, *children.at(1), symbols.typeOf(name), symbols);
+            code.text += ";\n";
         }
         else if (label == "expression")
         {
             for (const auto &child : children)
             {
-                code << child->generateCode();
+                child->emitCode(code, symbols);
             }
         }
         else if (label == "primary")
         {
-            code << children.at(0)->getValue();
+            code.text += children.at(0)->getValue();
         }
-        return code.str();
     }
 
     std::string getValue()
@@ -393,24 +795,244 @@ public:
         }
     }
 
+    void flatten(FlatAst &ast) const override
+    {
+        for (const auto &child : children)
+        {
+            child->flatten(ast);
+        }
+        ast.addNonTerminal(nodeKind(label), (uint32_t)children.size());
+    }
+
+    void collectReads(std::vector<std::string> &names) const override
+    {
+        for (const auto &child : children)
+        {
+            child->collectReads(names);
+        }
+    }
+
+    bool isLiteral() const override
+    {
+        return label == "expression" && children.size() == 1 && children[0]->isLiteral();
+    }
+
+    bool mayTrap() const override
+    {
+        return std::any_of(children.begin(), children.end(), [](const std::shared_ptr<ParseTreeNode> &child)
+                           { return child->mayTrap(); });
+    }
+
+    bool isSafeDivisor() const override
+    {
+        return label == "expression" && children.size() == 1 && children[0]->isSafeDivisor();
+    }
+
+    bool isNull() const override
+    {
+        return label == "expression" && children.size() == 1 && children[0]->isNull();
+    }
+
+private:
+    std::string label;
+    std::vector<std::shared_ptr<ParseTreeNode>> children;
+};
+
+class TerminalNode : public ParseTreeNode
+{
+public:
+    TerminalNode(const Token &token) : value(token.value), type(token.type), line(token.line) {}
+
+    void emitCode(CodeBuffer &code, const FrozenSymbolTable &, int = 0) const override
+    {
+        appendLiteral(code, type, value);
+    }
+
+    std::string getValue()
+    {
+        return this->value;
+    }
+
+    TokenType getType() const
+    {
+        return this->type;
+    }
+
+    size_t getLine() const
+    {
+        return line;
+    }
+
+    void print(int depth = 0) const override
+    {
+        for (int i = 0; i < depth; ++i)
+        {
+            std::cout << " ";
+        }
+        std::cout << this->value << "\n";
+    }
+
+    void flatten(FlatAst &ast) const override
+    {
+        ast.addTerminal({type, value, line});
+    }
+
+    void collectReads(std::vector<std::string> &names) const override
+    {
+        if (type == TokenType::IDENTIFIER)
+        {
+            names.push_back(value);
+        }
+    }
+
+    bool isLiteral() const override
+    {
+        return isLiteralToken(type);
+    }
+
+    bool isNull() const override
+    {
+        return type == TokenType::NULL_KEYWORD;
+    }
+
+    bool isSafeDivisor() const override
+    {
+        switch (type)
+        {
+        case TokenType::INT_LITERAL:
+        {
+            ConstValue divisor = intValue(value);
+            return divisor.kind == ConstValue::INT && divisor.integer > 0 && divisor.integer <= INT32_MAX;
+        }
+        case TokenType::FLOAT_LITERAL:
+            return std::strtod(value.c_str(), nullptr) != 0;
+        case TokenType::CHAR_LITERAL:
+        {
+            ConstValue divisor = charValue(value);
+            return divisor.kind == ConstValue::INT && divisor.integer > 0;
+        }
+        case TokenType::TRUE:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+private:
+    std::string value;
+    TokenType type;
+    size_t line;
+};
+
+/**
+ * Binary operation: <expression> operator <expression>
+ */
+class BinaryNode : public ParseTreeNode
+{
+public:
+    BinaryNode(const Token &op, const std::shared_ptr<ParseTreeNode> &lhs, const std::shared_ptr<ParseTreeNode> &rhs)
+        : op(op.type), line(op.line), lhs(lhs), rhs(rhs) {}
+
+    void emitCode(CodeBuffer &code, const FrozenSymbolTable &symbols, int = 0) const override
+    {
+        int precedence = getPrecedence();
+        emitOperand(code, *lhs, symbols, precedence);
+        code.text += ' ';
+        code.text += convertToken(op);
+        code.text += ' ';
+        emitOperand(code, *rhs, symbols, precedence + 1);
+    }
+
+    std::string getValue()
+    {
+        int precedence = getPrecedence();
+        std::string value = parenthesise(lhs->getValue(), lhs->getPrecedence(), precedence);
+        value += convertToken(op);
+        value += parenthesise(rhs->getValue(), rhs->getPrecedence(), precedence + 1);
+        return value;
+    }
+
+    void print(int depth = 0) const override
+    {
+        for (int i = 0; i < depth; ++i)
+        {
+            std::cout << " ";
+        }
+        std::cout << convertToken(op) << "\n";
+        lhs->print(depth + 1);
+        rhs->print(depth + 1);
+    }
+
+    void flatten(FlatAst &ast) const override
+    {
+        lhs->flatten(ast);
+        rhs->flatten(ast);
+        ast.addOperator(NodeKind::BINARY, {op, convertToken(op), line}, 2);
+    }
+
+    void collectReads(std::vector<std::string> &names) const override
+    {
+        lhs->collectReads(names);
+        rhs->collectReads(names);
+    }
+
+    bool mayTrap() const override
+    {
+        bool division = op == TokenType::DIVIDE || op == TokenType::MODULO;
+        return (division && !rhs->isSafeDivisor()) || lhs->mayTrap() || rhs->mayTrap();
+    }
+
+    int getPrecedence() const override
+    {
+        return binaryPrecedence(op);
+    }
+
+    TokenType getOperator() const
+    {
+        return op;
+    }
+
+    size_t getLine() const
+    {
+        return line;
+    }
+
+    const std::shared_ptr<ParseTreeNode> &getLhs() const
+    {
+        return lhs;
+    }
+
+    const std::shared_ptr<ParseTreeNode> &getRhs() const
+    {
+        return rhs;
+    }
+
 private:
-    std::string label;
-    std::vector<std::shared_ptr<ParseTreeNode>> children;
+    TokenType op;
+    size_t line;
+    std::shared_ptr<ParseTreeNode> lhs;
+    std::shared_ptr<ParseTreeNode> rhs;
 };
 
-class TerminalNode : public ParseTreeNode
+/**
+ * Prefix operation: ('-' | '!') <expression>
+ */
+class UnaryNode : public ParseTreeNode
 {
 public:
-    TerminalNode(const std::string &value) : value(value) {}
+    UnaryNode(const Token &op, const std::shared_ptr<ParseTreeNode> &operand)
+        : op(op.type), line(op.line), operand(operand) {}
 
-    std::string generateCode(int indentation = 0) const override
+    void emitCode(CodeBuffer &code, const FrozenSymbolTable &symbols, int = 0) const override
     {
-        return this->value;
+        // nested prefix operators are parenthesised so that '- -a' never becomes '--a'
+        code.text += convertToken(op);
+        emitOperand(code, *operand, symbols, UNARY_PRECEDENCE + 1);
     }
 
     std::string getValue()
     {
-        return this->value;
+        return convertToken(op) + parenthesise(operand->getValue(), operand->getPrecedence(), UNARY_PRECEDENCE + 1);
     }
 
     void print(int depth = 0) const override
@@ -419,13 +1041,150 @@ public:
         {
             std::cout << " ";
         }
-        std::cout << this->value << "\n";
+        std::cout << convertToken(op) << "\n";
+        operand->print(depth + 1);
+    }
+
+    void flatten(FlatAst &ast) const override
+    {
+        operand->flatten(ast);
+        ast.addOperator(NodeKind::UNARY, {op, convertToken(op), line}, 1);
+    }
+
+    void collectReads(std::vector<std::string> &names) const override
+    {
+        operand->collectReads(names);
+    }
+
+    bool isLiteral() const override
+    {
+        return op == TokenType::MINUS && operand->isLiteral();
+    }
+
+    bool mayTrap() const override
+    {
+        return operand->mayTrap();
+    }
+
+    int getPrecedence() const override
+    {
+        return UNARY_PRECEDENCE;
+    }
+
+    TokenType getOperator() const
+    {
+        return op;
+    }
+
+    size_t getLine() const
+    {
+        return line;
+    }
+
+    const std::shared_ptr<ParseTreeNode> &getOperand() const
+    {
+        return operand;
     }
 
 private:
+    TokenType op;
+    size_t line;
+    std::shared_ptr<ParseTreeNode> operand;
+};
+
+/**
+ * Linearises a parse tree
+ *
+ * @param tree root of the parse tree
+ * @return the same tree stored in post-order
+ */
+inline FlatAst flatten(const std::shared_ptr<ParseTreeNode> &tree)
+{
+    FlatAst ast;
+    tree->flatten(ast);
+    return ast;
+}
+
+/**
+ * Effect of a statement on the diagnostics or on the symbol
+ * table, recorded while parsing a chunk of the program on
+ * another thread and replayed in program order afterwards
+ */
+struct DeferredAction
+{
+    enum Kind
+    {
+        SYNTAX_ERROR,
+        SYMBOL_ERROR,
+        ADD_SYMBOL,
+        SET_VALUE,
+        USE_SYMBOL
+    };
+
+    Kind kind;
+    SymbolType type;
+    std::string name;
+    /**
+     * Error message, or text of the literal stored
+     */
     std::string value;
+    int line;
+    /**
+     * Type of the literal stored, see SymbolTable::literal()
+     */
+    TokenType literal = TokenType::UNDEFINED;
 };
 
+/**
+ * Value stored by an ADD_SYMBOL or SET_VALUE action
+ *
+ * @param st     symbol table the action is applied to
+ * @param action to evaluate
+ * @return value of the symbol after the action
+ */
+inline ConstValue actionValue(SymbolTable &st, const DeferredAction &action)
+{
+    SymbolType target = action.kind == DeferredAction::ADD_SYMBOL ? action.type : st.typeOf(action.name);
+    return st.literal(action.literal, action.value, target);
+}
+
+/**
+ * Executes an action recorded by a chunk parser
+ *
+ * @param st     symbol table
+ * @param action to replay
+ */
+inline void replayAction(SymbolTable &st, const DeferredAction &action)
+{
+    CompilationContext &context = st.getContext();
+    switch (action.kind)
+    {
+    case DeferredAction::SYNTAX_ERROR:
+        context.error(action.value);
+        break;
+    case DeferredAction::SYMBOL_ERROR:
+        context.error(action.value);
+        context.symbolTableError();
+        break;
+    case DeferredAction::ADD_SYMBOL:
+        st.addSymbol(action.type, action.name, action.line, actionValue(st, action));
+        break;
+    case DeferredAction::SET_VALUE:
+        st.setValue(action.name, actionValue(st, action), action.line);
+        break;
+    case DeferredAction::USE_SYMBOL:
+        if (!st.isDeclared(action.name))
+        {
+            std::stringstream ss;
+            ss << "Undeclared variable '" << action.name << "' was used ";
+            ss << "on line " << action.line << ".";
+            context.error(ss.str());
+            context.symbolTableError();
+        }
+        break;
+    }
+}
+
 /**
  *
  */
@@ -435,9 +1194,27 @@ public:
     /**
      * Default constructor
      *
-     * @param tokens obtained from Tokenizer.lex()
+     * @param context of the compilation
+     * @param tokens  obtained from Tokenizer.lex()
      */
-    Parser(std::vector<Token> &tokens) : tokens(tokens), index(0)
+    Parser(CompilationContext &context, std::vector<Token> &tokens)
+        : tokens(tokens), context(context), st(context), index(0)
+    {
+        this->currentToken = tokens[index];
+    }
+
+    /**
+     * Parser of a chunk of the program: nodes are allocated in
+     * the given arena and the symbol table is not touched, every
+     * action is recorded in 'actions' instead
+     *
+     * @param context of the compilation
+     * @param tokens  of the chunk, ending with _EOF
+     * @param arena   where nodes are allocated
+     * @param actions where actions on the symbol table are recorded
+     */
+    Parser(CompilationContext &context, std::vector<Token> &tokens, const std::shared_ptr<Arena> &arena, std::vector<DeferredAction> *actions)
+        : tokens(tokens), context(context), st(context), index(0), arena(arena), deferred(actions)
     {
         this->currentToken = tokens[index];
     }
@@ -455,11 +1232,12 @@ public:
     /**
      * Get the Symbol Table object
      *
-     * @return symbol table
+     * @return symbol table frozen at the end of parse(), shared
+     *         by whoever needs it
      */
-    SymbolTable getSymbolTable()
+    std::shared_ptr<const FrozenSymbolTable> getSymbolTable() const
     {
-        return this->st;
+        return this->symbols;
     }
 
     /**
@@ -467,16 +1245,33 @@ public:
      *
      * @return if analysis was successfull
      */
-    std::shared_ptr<ParseTreeNode> parse()
+    std::shared_ptr<ParseTreeNode> parse(unsigned jobs = 1)
     {
-        auto p = parseProgram();
-        st.print();
+        auto p = jobs > 1 ? parseProgram(jobs) : parseProgram();
+        st.print(context.getOutput());
+        symbols = st.freeze();
         return p;
     }
 
     bool isValid()
     {
-        return this->valid && symbolTableOk;
+        return this->valid && context.isSymbolTableOk();
+    }
+
+    /**
+     * Parses statements until the end of the tokens, without
+     * building the program node
+     *
+     * @return the statements found
+     */
+    std::vector<std::shared_ptr<ParseTreeNode>> parseStatements()
+    {
+        std::vector<std::shared_ptr<ParseTreeNode>> statements;
+        while (expand(NonTerminal::STATEMENTS) != Production::STATEMENTS_END)
+        {
+            statements.push_back(parseStatement());
+        }
+        return statements;
     }
 
 private:
@@ -490,11 +1285,21 @@ private:
      */
     Token currentToken;
 
+    /**
+     * Compilation the tokens belong to
+     */
+    CompilationContext &context;
+
     /**
      *
      */
     SymbolTable st;
 
+    /**
+     * Read only copy of 'st' made at the end of parse()
+     */
+    std::shared_ptr<const FrozenSymbolTable> symbols;
+
     /**
      * Index of the current token analysed
      */
@@ -505,16 +1310,123 @@ private:
      */
     bool valid = true;
 
-    // TODO:REMOVE - FOR DEBUGGING
-    void print(int offset = 0)
+    /**
+     * Where nodes are allocated, the heap if null
+     */
+    std::shared_ptr<Arena> arena;
+
+    /**
+     * Actions on the symbol table waiting to be replayed,
+     * null if they are executed immediately
+     */
+    std::vector<DeferredAction> *deferred = nullptr;
+
+    /**
+     * Chunks smaller than this are not worth a thread
+     */
+    static const size_t MIN_CHUNK_TOKENS = 4096;
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> makeNode(Args &&...args)
     {
-        std::cout << lookahead(offset).value << "\n";
+        if (arena)
+        {
+            return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+        }
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+
+    void syntaxError(const std::string &msg)
+    {
+        if (deferred)
+        {
+            deferred->push_back({DeferredAction::SYNTAX_ERROR, SymbolType::UNDEFINED, "", msg, 0});
+            return;
+        }
+        context.error(msg);
+    }
+
+    void symbolError(const std::string &msg)
+    {
+        if (deferred)
+        {
+            deferred->push_back({DeferredAction::SYMBOL_ERROR, SymbolType::UNDEFINED, "", msg, 0});
+            return;
+        }
+        context.error(msg);
+        context.symbolTableError();
+    }
+
+    void declareSymbol(SymbolType type, const std::string &name, int line, const Token &literal)
+    {
+        DeferredAction action = {DeferredAction::ADD_SYMBOL, type, name, literal.value, line, literal.type};
+        if (deferred)
+        {
+            deferred->push_back(action);
+            return;
+        }
+        replayAction(st, action);
+    }
+
+    void assignSymbol(const std::string &name, const Token &literal, int line)
+    {
+        DeferredAction action = {DeferredAction::SET_VALUE, SymbolType::UNDEFINED, name, literal.value, line, literal.type};
+        if (deferred)
+        {
+            deferred->push_back(action);
+            return;
+        }
+        replayAction(st, action);
     }
 
     /**
-     * Unabled constructor
+     * Literal an expression is made of
+     *
+     * @param expression returned by parseExpression()
+     * @return the literal, with a '-' in front if it is negated;
+     *         of type UNDEFINED if the expression is not a literal
      */
-    Parser() {}
+    static Token literalOf(const std::shared_ptr<ParseTreeNode> &expression)
+    {
+        Token literal = {TokenType::UNDEFINED, "", 0};
+        auto node = std::static_pointer_cast<NonTerminalNode>(expression)->getChildren().at(0);
+        bool negated = false;
+        auto unary = std::dynamic_pointer_cast<UnaryNode>(node);
+        if (unary && unary->getOperator() == TokenType::MINUS)
+        {
+            negated = true;
+            node = unary->getOperand();
+        }
+        auto terminal = std::dynamic_pointer_cast<TerminalNode>(node);
+        if (!terminal || terminal->getType() == TokenType::IDENTIFIER)
+        {
+            return literal;
+        }
+        if (negated && terminal->getType() != TokenType::INT_LITERAL && terminal->getType() != TokenType::FLOAT_LITERAL)
+        {
+            return literal;
+        }
+        literal.type = terminal->getType();
+        literal.value = negated ? "-" + terminal->getValue() : terminal->getValue();
+        return literal;
+    }
+
+    void useSymbol(const std::string &name, int line)
+    {
+        DeferredAction action = {DeferredAction::USE_SYMBOL, SymbolType::UNDEFINED, name, "", line};
+        if (deferred)
+        {
+            deferred->push_back(action);
+            return;
+        }
+        replayAction(st, action);
+    }
+
+    // TODO:REMOVE - FOR DEBUGGING
+    void print(int offset = 0)
+    {
+        std::cout << lookahead(offset).value << "\n";
+    }
 
     void consume()
     {
@@ -546,30 +1458,20 @@ private:
         return first == second;
     }
 
-    bool checkTokenType(std::vector<TokenType> first, TokenType second = TokenType::UNDEFINED)
+    bool checkTokenType(TokenSet set) const
     {
-        if (second == TokenType::UNDEFINED)
-        {
-            second = currentToken.type;
-        }
-        for (TokenType type : first)
-        {
-            if (type == second)
-            {
-                return true;
-            }
-        }
-        return false;
+        return set.contains(currentToken.type);
     }
 
-    bool isDataType()
+    /**
+     * Production of the LL(1) table for the current token
+     *
+     * @param nt non terminal to expand
+     * @return production, Production::NONE on a syntax error
+     */
+    Production expand(NonTerminal nt) const
     {
-        return checkTokenType(
-            {TokenType::BOOLEAN_KEYWORD,
-             TokenType::INT_KEYWORD,
-             TokenType::FLOAT_KEYWORD,
-             TokenType::CHAR_KEYWORD,
-             TokenType::STRING_KEYWORD});
+        return predict(nt, currentToken.type);
     }
 
     void notValid()
@@ -583,7 +1485,7 @@ private:
         ss << "Expected " << msg << ". ";
         ss << "Token '" << t.value;
         ss << "' was given at line " << t.line << ".";
-        errorMessage(ss.str());
+        syntaxError(ss.str());
         notValid();
     }
 
@@ -610,7 +1512,11 @@ private:
     SymbolType getSymbolType(const std::string &type)
     {
         SymbolType st = SymbolType::UNDEFINED;
-        if (type == "int")
+        if (type == "boolean")
+        {
+            st = SymbolType::BOOLEAN;
+        }
+        else if (type == "int")
         {
             st = SymbolType::INT;
         }
@@ -630,8 +1536,7 @@ private:
         {
             std::stringstream ss;
             ss << "Unknown type " << type << ".";
-            errorMessage(ss.str());
-            symTableError();
+            symbolError(ss.str());
         }
         return st;
     }
@@ -639,7 +1544,11 @@ private:
     SymbolType getSymbolType(const TokenType type)
     {
         SymbolType st = SymbolType::UNDEFINED;
-        if (type == TokenType::INT_KEYWORD)
+        if (type == TokenType::BOOLEAN_KEYWORD)
+        {
+            st = SymbolType::BOOLEAN;
+        }
+        else if (type == TokenType::INT_KEYWORD)
         {
             st = SymbolType::INT;
         }
@@ -659,67 +1568,91 @@ private:
         {
             std::stringstream ss;
             ss << "Unknown type " << convertToken(type) << ".";
-            errorMessage(ss.str());
-            symTableError();
+            symbolError(ss.str());
         }
         return st;
     }
 
-    bool isDeclaration()
-    {
-        return isDataType();
-    }
-
-    bool isIdDeclaration()
+    std::shared_ptr<ParseTreeNode> parsePrimary()
     {
-        bool check = false;
-        if (checkTokenType(TokenType::IDENTIFIER, lookahead().type))
+        Production production = expand(NonTerminal::PRIMARY);
+        if (production == Production::PRIMARY_GROUP)
         {
-            if (checkTokenType({TokenType::ASSIGN, TokenType::SEMICOLON}, lookahead(2).type))
+            consume();
+            auto node = parseBinary(1);
+            if (!checkTokenType(TokenType::CLOSE_PARENTHESIS))
             {
-                check = true;
+                expected(currentToken, "')'");
+                tokens.insert(tokens.begin() + index, {TokenType::CLOSE_PARENTHESIS, "undefined", currentToken.line});
+                update();
             }
+            consume();
+            return node;
         }
-        return check;
-    }
 
-    bool isAssignment()
-    {
-        if (!checkTokenType(TokenType::IDENTIFIER))
+        if (production == Production::NONE)
         {
-            return false;
+            expected(currentToken, "expression");
+            tokens.insert(tokens.begin() + index, {TokenType::NULL_KEYWORD, "undefined", currentToken.line});
+            update();
+        }
+        else if (production == Production::PRIMARY_IDENTIFIER)
+        {
+            useSymbol(currentToken.value, currentToken.line);
         }
-        return checkTokenType(TokenType::ASSIGN, lookahead().type);
+
+        auto node = makeNode<TerminalNode>(currentToken);
+        consume();
+        return node;
     }
 
-    bool isExpression()
+    std::shared_ptr<ParseTreeNode> parseUnary()
     {
-        return checkTokenType({TokenType::TRUE,
-                               TokenType::FALSE,
-                               TokenType::INT_LITERAL,
-                               TokenType::FLOAT_LITERAL,
-                               TokenType::CHAR_LITERAL,
-                               TokenType::STRING_LITERAL});
+        Production production = expand(NonTerminal::UNARY);
+        if (production == Production::UNARY_MINUS || production == Production::UNARY_NOT)
+        {
+            Token op = currentToken;
+            consume();
+            return makeNode<UnaryNode>(op, parseUnary());
+        }
+        return parsePrimary();
     }
 
-    std::shared_ptr<ParseTreeNode> parsePrimary()
+    /**
+     * Precedence climbing: parses operators binding at least
+     * as tight as 'minPrecedence', one loop iteration per operator
+     *
+     * @param minPrecedence lowest precedence accepted
+     * @return root of the expression
+     */
+    std::shared_ptr<ParseTreeNode> parseBinary(int minPrecedence)
     {
-        auto node = std::make_shared<TerminalNode>(currentToken.value);
-        consume();
-        return node;
+        auto lhs = parseUnary();
+        int precedence = binaryPrecedence(currentToken.type);
+        while (precedence >= minPrecedence && precedence > 0)
+        {
+            Token op = currentToken;
+            consume();
+            // operators are left associative: the right operand only
+            // takes operators binding tighter than this one
+            auto rhs = parseBinary(precedence + 1);
+            lhs = makeNode<BinaryNode>(op, lhs, rhs);
+            precedence = binaryPrecedence(currentToken.type);
+        }
+        return lhs;
     }
 
     std::shared_ptr<ParseTreeNode> parseExpression()
     {
-        auto node = std::make_shared<NonTerminalNode>("expression");
-        node->addChild(parsePrimary());
+        auto node = makeNode<NonTerminalNode>("expression");
+        node->addChild(parseBinary(1));
         return node;
     }
 
     std::shared_ptr<ParseTreeNode> parseIdDeclaration()
     {
-        auto node = std::make_shared<NonTerminalNode>("id_declaration");
-        node->addChild(std::make_shared<TerminalNode>(currentToken.value));
+        auto node = makeNode<NonTerminalNode>("id_declaration");
+        node->addChild(makeNode<TerminalNode>(currentToken));
         SymbolType dataType = getSymbolType(currentToken.type);
         consume();
         if (!checkTokenType(TokenType::IDENTIFIER))
@@ -728,30 +1661,33 @@ private:
             tokens.insert(tokens.begin() + index, {TokenType::IDENTIFIER, "undefined", currentToken.line});
             update();
         }
-        node->addChild(std::make_shared<TerminalNode>(currentToken.value));
+        node->addChild(makeNode<TerminalNode>(currentToken));
         std::string name = currentToken.value;
         int line = currentToken.line;
         consume();
 
-        if (isExpression())
+        Production initialiser = expand(NonTerminal::INITIALISER);
+        if (initialiser == Production::NONE && checkTokenType(EXPRESSION_START))
         {
             expected(currentToken, "assign symbol '='");
             tokens.insert(tokens.begin() + index, {TokenType::ASSIGN, "undefined", currentToken.line});
             update();
+            initialiser = Production::INITIALISER_ASSIGN;
         }
 
-        std::string value = "nullptr";
-        if (checkTokenType(TokenType::ASSIGN))
+        Token value = {TokenType::_EOF, "", (size_t)line};
+        if (initialiser == Production::INITIALISER_ASSIGN)
         {
             consume();
-            if (!isExpression())
+            if (!checkTokenType(EXPRESSION_START))
             {
                 expected(currentToken, "expression");
                 tokens.insert(tokens.begin() + index, {TokenType::NULL_KEYWORD, "undefined", currentToken.line});
                 update();
             }
-            node->addChild(parseExpression());
-            value = currentToken.value;
+            auto expression = parseExpression();
+            node->addChild(expression);
+            value = literalOf(expression);
         }
 
         if (!checkTokenType(TokenType::SEMICOLON))
@@ -762,32 +1698,40 @@ private:
         }
         consume();
 
-        st.addSymbol(dataType, name, line, value);
+        declareSymbol(dataType, name, line, value);
         return node;
     }
 
     std::shared_ptr<ParseTreeNode> parseDeclaration()
     {
-        auto node = std::make_shared<NonTerminalNode>("declaration");
+        auto node = makeNode<NonTerminalNode>("declaration");
         node->addChild(parseIdDeclaration());
         return node;
     }
 
     std::shared_ptr<ParseTreeNode> parseAssignment()
     {
-        auto node = std::make_shared<NonTerminalNode>("assignment");
-        node->addChild(std::make_shared<TerminalNode>(currentToken.value));
+        auto node = makeNode<NonTerminalNode>("assignment");
+        node->addChild(makeNode<TerminalNode>(currentToken));
         std::string id = currentToken.value;
+        int line = currentToken.line;
         consume();
+        if (!checkTokenType(TokenType::ASSIGN))
+        {
+            expected(currentToken, "assign symbol '='");
+            tokens.insert(tokens.begin() + index, {TokenType::ASSIGN, "undefined", currentToken.line});
+            update();
+        }
         consume();
-        if (!isExpression())
+        if (!checkTokenType(EXPRESSION_START))
         {
             expected(currentToken, "expression");
             tokens.insert(tokens.begin() + index, {TokenType::NULL_KEYWORD, "undefined", currentToken.line});
             update();
         }
-        node->addChild(parseExpression());
-        
+        auto expression = parseExpression();
+        node->addChild(expression);
+
         if (!checkTokenType(TokenType::SEMICOLON))
         {
             expected(currentToken, "semicolon");
@@ -796,60 +1740,181 @@ private:
         }
         consume();
 
-        st.setValue(id, node->getValue(1), currentToken.line);
+        assignSymbol(id, literalOf(expression), line);
         return node;
     }
 
     std::shared_ptr<ParseTreeNode> parseStatement()
     {
-        std::shared_ptr<NonTerminalNode> node = std::make_shared<NonTerminalNode>("statement");
-        if (isDeclaration())
+        auto node = makeNode<NonTerminalNode>("statement");
+        switch (expand(NonTerminal::STATEMENT))
         {
+        case Production::STATEMENT_DECLARATION:
             node->addChild(parseDeclaration());
-        }
-        else if (isAssignment())
-        {
+            break;
+        case Production::STATEMENT_ASSIGNMENT:
             node->addChild(parseAssignment());
-        }
-        else
+            break;
+        default:
         {
             std::stringstream ss;
             ss << "Unable to determine kind of statement at line " << currentToken.line << ".";
-            errorMessage(ss.str());
+            syntaxError(ss.str());
             // Skips all tokens until next statement or EOF
-            while (!checkTokenType({TokenType::SEMICOLON, TokenType::_EOF}))
+            while (!checkTokenType(STATEMENT_END))
             {
                 consume();
             }
             notValid();
             consume();
+            break;
+        }
         }
         return node;
     }
 
     std::shared_ptr<ParseTreeNode> parseProgram()
     {
-        auto node = std::make_shared<NonTerminalNode>("program");
-        while (!checkTokenType(TokenType::_EOF))
+        auto node = makeNode<NonTerminalNode>("program");
+        while (expand(NonTerminal::STATEMENTS) != Production::STATEMENTS_END)
         {
             node->addChild(parseStatement());
         }
         return node;
     }
+
+    /**
+     * Parses the program on several threads. Statements cannot
+     * nest, so the tokens are split in chunks right after a ';'
+     * and every chunk is parsed by its own parser. Their
+     * statements and symbol table actions are then merged in
+     * order, so diagnostics are the same as a serial parse.
+     *
+     * @param jobs maximum number of threads
+     * @return root of the parse tree
+     */
+    std::shared_ptr<ParseTreeNode> parseProgram(unsigned jobs)
+    {
+        size_t count = tokens.size() - 1;
+        size_t chunkCount = std::min<size_t>(jobs, count / MIN_CHUNK_TOKENS);
+        if (chunkCount < 2)
+        {
+            return parseProgram();
+        }
+
+        // every chunk ends right after the first ';' following its share of tokens
+        std::vector<size_t> bounds = {0};
+        for (size_t c = 1; c < chunkCount; ++c)
+        {
+            size_t i = std::max(bounds.back(), count * c / chunkCount);
+            while (i < count && tokens[i].type != TokenType::SEMICOLON)
+            {
+                ++i;
+            }
+            if (i < count)
+            {
+                bounds.push_back(i + 1);
+            }
+        }
+        bounds.push_back(count);
+
+        size_t chunks = bounds.size() - 1;
+        std::vector<std::vector<std::shared_ptr<ParseTreeNode>>> statements(chunks);
+        std::vector<std::vector<DeferredAction>> actions(chunks);
+        std::vector<char> chunkValid(chunks, 1);
+        std::vector<std::thread> workers;
+        for (size_t c = 0; c < chunks; ++c)
+        {
+            workers.emplace_back([&, c]()
+            {
+                std::vector<Token> slice(tokens.begin() + bounds[c], tokens.begin() + bounds[c + 1]);
+                slice.push_back(tokens.back());
+                Parser parser(context, slice, std::make_shared<Arena>(), &actions[c]);
+                statements[c] = parser.parseStatements();
+                chunkValid[c] = parser.valid;
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+
+        auto node = makeNode<NonTerminalNode>("program");
+        for (size_t c = 0; c < chunks; ++c)
+        {
+            for (const auto &statement : statements[c])
+            {
+                node->addChild(statement);
+            }
+            for (const auto &action : actions[c])
+            {
+                replayAction(st, action);
+            }
+            if (!chunkValid[c])
+            {
+                notValid();
+            }
+        }
+        return node;
+    }
 };
 
 class CodeGenerator
 {
 public:
-    CodeGenerator(const SymbolTable &st) : st(st) {}
+    /**
+     * Default constructor
+     *
+     * @param symbols of the program
+     * @param headers the code includes
+     */
+    CodeGenerator(std::shared_ptr<const FrozenSymbolTable> symbols, HeaderMode headers = HeaderMode::IOSTREAM)
+        : symbols(std::move(symbols)), headers(headers) {}
 
+    /**
+     * Code of a program with its headers: they depend on what the
+     * code uses, so they are chosen last
+     *
+     * @param parseTree of the program
+     * @return the code
+     */
     std::string generateCode(std::shared_ptr<ParseTreeNode> &parseTree) const
     {
-        return parseTree->generateCode();
+        CodeBuffer body = generateBody(parseTree);
+        std::string code = includes(body);
+        code += body.text;
+        return code;
+    }
+
+    /**
+     * Code of a program without its headers, to be put in a
+     * file with the code of other programs
+     *
+     * @param parseTree of the program
+     * @return the main function of the program
+     */
+    CodeBuffer generateBody(std::shared_ptr<ParseTreeNode> &parseTree) const
+    {
+        CodeBuffer body;
+        parseTree->emitCode(body, *symbols);
+        return body;
+    }
+
+    /**
+     * Headers the code of a program needs
+     *
+     * @param body code of the program, from generateBody
+     * @return include directives
+     */
+    std::string includes(const CodeBuffer &body) const
+    {
+        return includesFor(*symbols, headers, body.usesNull);
     }
 
 private:
-    const SymbolTable &st;
+    std::shared_ptr<const FrozenSymbolTable> symbols;
+
+    HeaderMode headers;
 };
 
 #endif // G_PARSER_HPP
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+ * @file    G-Programming-Language/Compiler/partial_evaluation.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_PARTIAL_EVALUATION_HPP
+#define G_PARTIAL_EVALUATION_HPP
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./interner.hpp"
+#include "./parser_new.hpp"
+
+/**
+ * Outcome of the evaluation of a whole program
+ */
+struct Evaluation
+{
+    /**
+     * If the program was replaced by its residual program
+     */
+    bool evaluated = false;
+
+    /**
+     * Statements before and after
+     */
+    size_t statements = 0;
+    size_t residual = 0;
+
+    /**
+     * First store whose value is not a constant, when the
+     * program could not be evaluated
+     */
+    std::string variable;
+    size_t line = 0;
+};
+
+/**
+ * Checks if an expression is a constant, as folding leaves it:
+ * a literal, NULL, or a negated number
+ */
+inline bool isConstantExpression(const std::shared_ptr<ParseTreeNode> &expression)
+{
+    ParseTreeNode *root = static_cast<NonTerminalNode &>(*expression).getChildren().at(0).get();
+    if (auto unary = dynamic_cast<UnaryNode *>(root))
+    {
+        if (unary->getOperator() != TokenType::MINUS)
+        {
+            return false;
+        }
+        root = unary->getOperand().get();
+    }
+    auto terminal = dynamic_cast<TerminalNode *>(root);
+    return terminal && terminal->getType() != TokenType::IDENTIFIER;
+}
+
+/**
+ * Replaces a program by its residual program: a program has no
+ * input, so once constants are folded, the value of every store
+ * is known and all that is left to observe are the final values.
+ * Each declaration is kept, in order, initialised with the last
+ * value stored in the variable, and every assignment is removed.
+ *
+ * Run after constant folding. If some stored value is still not
+ * a constant (an overflow, a division by zero, a read of an
+ * uninitialised variable) the program is left untouched.
+ *
+ * @param program root of a valid, folded parse tree
+ * @return what was done
+ */
+inline Evaluation evaluateProgram(const std::shared_ptr<ParseTreeNode> &program)
+{
+    Evaluation evaluation;
+    auto root = std::static_pointer_cast<NonTerminalNode>(program);
+    const auto &statements = root->getChildren();
+    evaluation.statements = statements.size();
+
+    StringInterner names;
+    // declarations[id] and values[id]: the declaration of the
+    // variable and the expression it was stored last, if any
+    std::vector<std::shared_ptr<NonTerminalNode>> declarations;
+    std::vector<std::shared_ptr<ParseTreeNode>> values;
+    std::vector<std::shared_ptr<ParseTreeNode>> residual;
+
+    for (const auto &child : statements)
+    {
+        auto statement = std::static_pointer_cast<NonTerminalNode>(child);
+        auto node = std::static_pointer_cast<NonTerminalNode>(statement->getChildren().at(0));
+        bool isDeclaration = node->getLabel() == "declaration";
+        if (isDeclaration)
+        {
+            node = std::static_pointer_cast<NonTerminalNode>(node->getChildren().at(0));
+        }
+        size_t expression = isDeclaration ? 2 : 1;
+        auto name = std::static_pointer_cast<TerminalNode>(node->getChildren().at(expression - 1));
+        uint32_t id = names.intern(name->getValue());
+        if (id >= values.size())
+        {
+            declarations.resize(id + 1);
+            values.resize(id + 1);
+        }
+
+        if (isDeclaration)
+        {
+            declarations[id] = node;
+            residual.push_back(statement);
+        }
+        if (node->getChildren().size() > expression)
+        {
+            values[id] = node->getChildren()[expression];
+            if (!isConstantExpression(values[id]))
+            {
+                evaluation.variable = name->getValue();
+                evaluation.line = name->getLine();
+                return evaluation;
+            }
+        }
+    }
+
+    for (uint32_t id = 0; id < names.size(); ++id)
+    {
+        const auto &declaration = declarations[id];
+        if (values[id] && (declaration->getChildren().size() < 3 || declaration->getChildren()[2] != values[id]))
+        {
+            declaration->replaceChildren(2, declaration->getChildren().size() - 2, {values[id]});
+        }
+    }
+    root->replaceChildren(0, statements.size(), residual);
+    evaluation.evaluated = true;
+    evaluation.residual = residual.size();
+    return evaluation;
+}
+
+#endif // G_PARTIAL_EVALUATION_HPP
@@ -0,0 +1,285 @@
+/**
+ * @file    G-Programming-Language/Compiler/pass_manager.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_PASS_MANAGER_HPP
+#define G_PASS_MANAGER_HPP
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "./context.hpp"
+#include "./ir.hpp"
+#include "./parser_new.hpp"
+#include "./symbols.hpp"
+
+/**
+ * Allocations made so far by the calling thread. The operator
+ * new of the executable counts them (see counted_allocations.hpp);
+ * when it does not, they stay zero.
+ */
+inline size_t &threadAllocations()
+{
+    thread_local size_t count = 0;
+    return count;
+}
+
+/**
+ * Bytes allocated so far by the calling thread
+ */
+inline size_t &threadAllocatedBytes()
+{
+    thread_local size_t bytes = 0;
+    return bytes;
+}
+
+/**
+ * What the passes work on: the parse tree with its symbols and,
+ * once it has been lowered, the program in SSA form
+ */
+struct Module
+{
+    std::shared_ptr<ParseTreeNode> tree;
+    std::shared_ptr<const FrozenSymbolTable> symbols;
+    std::unique_ptr<IrProgram> ir;
+
+    /**
+     * Number of statements of the tree
+     */
+    size_t statements() const
+    {
+        return std::static_pointer_cast<NonTerminalNode>(tree)->getChildren().size();
+    }
+
+    /**
+     * Number of instructions of the IR, zero before lowering
+     */
+    size_t instructions() const
+    {
+        return ir ? ir->getInstructions().size() : 0;
+    }
+};
+
+/**
+ * Measures of one run of a pass
+ */
+struct PassStats
+{
+    std::string name;
+    double milliseconds;
+    size_t allocations;
+    size_t bytes;
+    size_t statementsBefore;
+    size_t statementsAfter;
+    size_t instructionsBefore;
+    size_t instructionsAfter;
+};
+
+/**
+ * Runs the analysis and optimisation passes between parsing and
+ * code generation, in the order they were added, and measures
+ * each of them
+ */
+class PassManager
+{
+public:
+    using Run = std::function<void(Module &, CompilationContext &)>;
+
+    /**
+     * Default constructor
+     *
+     * @param context of the compilation
+     */
+    explicit PassManager(CompilationContext &context) : context(context) {}
+
+    /**
+     * Adds a pass at the end of the pipeline
+     *
+     * @param name of the pass, used by the command line flags
+     * @param run  what the pass does
+     */
+    void add(const std::string &name, Run run)
+    {
+        passes.push_back({name, std::move(run), true, false});
+    }
+
+    /**
+     * Keeps a pass from running
+     *
+     * @param name of the pass
+     * @return false if there is no such pass
+     */
+    bool disable(const std::string &name)
+    {
+        return set(name, [](Pass &pass)
+                   { pass.enabled = false; });
+    }
+
+    /**
+     * Prints the program after a pass, "all" for every pass
+     *
+     * @param name of the pass
+     * @return false if there is no such pass
+     */
+    bool printAfter(const std::string &name)
+    {
+        return set(name, [](Pass &pass)
+                   { pass.print = true; });
+    }
+
+    /**
+     * Runs the enabled passes in order
+     *
+     * @param module to transform
+     */
+    void run(Module &module)
+    {
+        for (Pass &pass : passes)
+        {
+            if (!pass.enabled)
+            {
+                continue;
+            }
+            measure(pass.name, module, pass.run);
+            if (pass.print)
+            {
+                print(pass.name, module);
+            }
+        }
+    }
+
+    /**
+     * Runs a step of the compilation that is not a pass, and
+     * measures it like one
+     *
+     * @param name   of the step, as reported
+     * @param module it works on
+     * @param run    what the step does
+     */
+    void measure(const std::string &name, Module &module, const Run &run)
+    {
+        PassStats stats = {name, 0, threadAllocations(), threadAllocatedBytes(),
+                           module.statements(), 0, module.instructions(), 0};
+        auto start = std::chrono::steady_clock::now();
+        run(module, context);
+        auto end = std::chrono::steady_clock::now();
+        stats.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        stats.allocations = threadAllocations() - stats.allocations;
+        stats.bytes = threadAllocatedBytes() - stats.bytes;
+        stats.statementsAfter = module.statements();
+        stats.instructionsAfter = module.instructions();
+        this->stats.push_back(stats);
+    }
+
+    /**
+     * Prints the measures as a table
+     *
+     * @param out stream to print to
+     */
+    void report(std::ostream &out) const
+    {
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-12s %10s %12s %14s %21s %21s\n",
+                      "pass", "ms", "allocations", "bytes", "statements", "instructions");
+        out << line;
+        double total = 0;
+        for (const PassStats &s : stats)
+        {
+            std::snprintf(line, sizeof(line), "%-12s %10.3f %12zu %14zu %10zu -> %-7zu %10zu -> %-7zu\n",
+                          s.name.c_str(), s.milliseconds, s.allocations, s.bytes,
+                          s.statementsBefore, s.statementsAfter, s.instructionsBefore, s.instructionsAfter);
+            out << line;
+            total += s.milliseconds;
+        }
+        std::snprintf(line, sizeof(line), "%-12s %10.3f\n", "total", total);
+        out << line;
+    }
+
+    /**
+     * Writes the measures as JSON
+     *
+     * @param out stream to write to
+     */
+    void writeJson(std::ostream &out) const
+    {
+        out << "{\n  \"passes\": [";
+        for (size_t i = 0; i < stats.size(); ++i)
+        {
+            const PassStats &s = stats[i];
+            char number[32];
+            std::snprintf(number, sizeof(number), "%.6f", s.milliseconds);
+            out << (i ? ",\n" : "\n") << "    {\"name\": \"" << s.name << "\", \"ms\": " << number
+                << ", \"allocations\": " << s.allocations << ", \"bytes\": " << s.bytes
+                << ", \"statements\": [" << s.statementsBefore << ", " << s.statementsAfter << "]"
+                << ", \"instructions\": [" << s.instructionsBefore << ", " << s.instructionsAfter << "]}";
+        }
+        double total = 0;
+        for (const PassStats &s : stats)
+        {
+            total += s.milliseconds;
+        }
+        char number[32];
+        std::snprintf(number, sizeof(number), "%.6f", total);
+        out << "\n  ],\n  \"total_ms\": " << number << "\n}\n";
+    }
+
+private:
+    struct Pass
+    {
+        std::string name;
+        Run run;
+        bool enabled;
+        bool print;
+    };
+
+    CompilationContext &context;
+
+    std::vector<Pass> passes;
+
+    std::vector<PassStats> stats;
+
+    bool set(const std::string &name, const std::function<void(Pass &)> &change)
+    {
+        bool found = false;
+        for (Pass &pass : passes)
+        {
+            if (name == "all" || pass.name == name)
+            {
+                change(pass);
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * Prints the IR if the program was lowered, the C++ of the
+     * tree otherwise
+     */
+    void print(const std::string &name, const Module &module) const
+    {
+        std::ostream &out = context.getOutput();
+        out << "*** after " << name << " ***\n";
+        if (module.ir)
+        {
+            module.ir->dump(out);
+        }
+        else
+        {
+            out << module.tree->generateCode(*module.symbols) << "\n";
+        }
+    }
+};
+
+#endif // G_PASS_MANAGER_HPP
@@ -0,0 +1,496 @@
+/**
+ * @file    G-Programming-Language/Compiler/range_analysis.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_RANGE_ANALYSIS_HPP
+#define G_RANGE_ANALYSIS_HPP
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "./context.hpp"
+#include "./interner.hpp"
+#include "./parser_new.hpp"
+#include "./symbols.hpp"
+
+/**
+ * Value range analysis of the int variables, to store each one
+ * in the narrowest integer type that holds all its values.
+ *
+ * Statements run in order, so the range of a variable at a read
+ * is the range of its last store, and the range it needs is the
+ * union of the ranges of all its stores. Ranges follow the C++
+ * the program is translated to: arithmetic on ints is done in
+ * int whatever the storage, and an int holds only ints, so a
+ * variable never needs more than 32 bits. A decimal literal too
+ * big for an int (a long in C++) is reported, since storing it
+ * wraps.
+ *
+ * Bounds are doubles: exact for every value of a long up to 2^53
+ * and for every product of two ints, which is all the precision
+ * the limits of int8_t, int16_t and int need.
+ */
+class RangeAnalysis
+{
+public:
+    /**
+     * Range of a variable and the bits chosen for it
+     */
+    struct Decision
+    {
+        std::string name;
+        int line;
+        double low;
+        double high;
+        uint8_t bits;
+    };
+
+    /**
+     * Default constructor
+     *
+     * @param context of the compilation, receives the diagnostics
+     * @param symbols of the program
+     */
+    RangeAnalysis(CompilationContext &context, const FrozenSymbolTable &symbols)
+        : context(context), symbols(symbols) {}
+
+    /**
+     * Analyses a program
+     *
+     * @param program root of a valid parse tree
+     * @return the symbol table with the bits of every int
+     */
+    std::shared_ptr<const FrozenSymbolTable> run(const std::shared_ptr<ParseTreeNode> &program)
+    {
+        auto root = std::static_pointer_cast<NonTerminalNode>(program);
+        for (const auto &child : root->getChildren())
+        {
+            auto statement = std::static_pointer_cast<NonTerminalNode>(child);
+            auto node = std::static_pointer_cast<NonTerminalNode>(statement->getChildren().at(0));
+            if (node->getLabel() == "declaration")
+            {
+                node = std::static_pointer_cast<NonTerminalNode>(node->getChildren().at(0));
+                std::string name = node->getValue(1);
+                SymbolType type = symbols.typeOf(name);
+                uint32_t id = idOf(name);
+                if (node->getChildren().size() == 3)
+                {
+                    store(id, type, node->getChildren()[2]);
+                }
+                else
+                {
+                    // the value of an uninitialised variable is anything
+                    current[id] = rangeOf(type);
+                }
+            }
+            else
+            {
+                std::string name = node->getValue(0);
+                store(idOf(name), symbols.typeOf(name), node->getChildren().at(1));
+            }
+        }
+
+        std::vector<FrozenSymbol> narrowed = symbols.getSymbols();
+        for (FrozenSymbol &symbol : narrowed)
+        {
+            uint32_t id = names.find(symbol.name);
+            if (symbol.type != SymbolType::INT || id == StringInterner::NO_ID || !stored[id].isStored())
+            {
+                continue;
+            }
+            const Range &range = stored[id];
+            symbol.bits = range.low >= INT8_MIN && range.high <= INT8_MAX     ? 8
+                          : range.low >= INT16_MIN && range.high <= INT16_MAX ? 16
+                                                                              : 0;
+            decisions.push_back({symbol.name, symbol.line, range.low, range.high, symbol.bits});
+        }
+        return std::make_shared<const FrozenSymbolTable>(std::move(narrowed), symbols.getStrings());
+    }
+
+    /**
+     * Ranges of the int variables, sorted by name
+     */
+    const std::vector<Decision> &getDecisions() const
+    {
+        return decisions;
+    }
+
+    /**
+     * Number of ints stored in a number of bits
+     *
+     * @param bits 8, 16, or 0 for a plain int
+     */
+    size_t count(uint8_t bits) const
+    {
+        return std::count_if(decisions.begin(), decisions.end(), [bits](const Decision &decision)
+                             { return decision.bits == bits; });
+    }
+
+    /**
+     * Prints the range and the type of every int
+     *
+     * @param out stream to print to
+     */
+    void report(std::ostream &out) const
+    {
+        for (const Decision &decision : decisions)
+        {
+            char line[96];
+            std::snprintf(line, sizeof(line), " [%.0f, %.0f] %s (line %d)\n", decision.low, decision.high,
+                          decision.bits == 8 ? "int8_t" : decision.bits == 16 ? "int16_t"
+                                                                               : "int",
+                          decision.line);
+            out << "    " << decision.name << line;
+        }
+    }
+
+private:
+    /**
+     * C++ type of an expression, as far as ranges go
+     */
+    enum class Kind : uint8_t
+    {
+        /**
+         * bool, char or int: an int once used in arithmetic
+         */
+        INT,
+        LONG,
+        /**
+         * float or double, whose range is not tracked
+         */
+        REAL,
+        /**
+         * Strings, and anything whose range is unknown
+         */
+        OTHER
+    };
+
+    struct Range
+    {
+        Kind kind;
+        double low;
+        double high;
+
+        /**
+         * The empty range of a variable never stored
+         */
+        bool isStored() const
+        {
+            return low <= high;
+        }
+    };
+
+    CompilationContext &context;
+
+    const FrozenSymbolTable &symbols;
+
+    /**
+     * Variables by id, the range of their current value and the
+     * union of the ranges of all their stores
+     */
+    StringInterner names;
+    std::vector<Range> current;
+    std::vector<Range> stored;
+
+    std::vector<Decision> decisions;
+
+    uint32_t idOf(const std::string &name)
+    {
+        uint32_t id = names.intern(name);
+        if (id >= current.size())
+        {
+            current.resize(id + 1, {Kind::OTHER, 0, 0});
+            stored.resize(id + 1, {Kind::INT, INFINITY, -INFINITY});
+        }
+        return id;
+    }
+
+    static Range full(Kind kind)
+    {
+        switch (kind)
+        {
+        case Kind::INT:
+            return {kind, INT32_MIN, INT32_MAX};
+        case Kind::LONG:
+            return {kind, (double)INT64_MIN, (double)INT64_MAX};
+        default:
+            return {kind, -INFINITY, INFINITY};
+        }
+    }
+
+    /**
+     * Every value a variable of a type can hold
+     */
+    static Range rangeOf(SymbolType type)
+    {
+        switch (type)
+        {
+        case SymbolType::BOOLEAN:
+            return {Kind::INT, 0, 1};
+        case SymbolType::CHAR:
+            return {Kind::INT, CHAR_MIN, CHAR_MAX};
+        case SymbolType::INT:
+            return full(Kind::INT);
+        case SymbolType::FLOAT:
+            return full(Kind::REAL);
+        default:
+            return full(Kind::OTHER);
+        }
+    }
+
+    /**
+     * Range of an expression stored in a variable: converting
+     * to the type of the variable keeps the values that fit,
+     * and may give any value of the type otherwise
+     *
+     * @param id         of the variable
+     * @param type       of the variable
+     * @param expression node of the statement
+     */
+    void store(uint32_t id, SymbolType type, const std::shared_ptr<ParseTreeNode> &expression)
+    {
+        const auto &root = static_cast<NonTerminalNode &>(*expression).getChildren().at(0);
+        auto terminal = dynamic_cast<TerminalNode *>(root.get());
+        Range limits = rangeOf(type);
+        Range range = limits;
+        if (terminal && terminal->getType() == TokenType::NULL_KEYWORD)
+        {
+            // the value initialised type
+            range = {limits.kind, 0, 0};
+        }
+        else if (limits.kind == Kind::INT)
+        {
+            Range value = evaluate(root);
+            if (value.kind == Kind::INT || value.kind == Kind::LONG)
+            {
+                if (value.low >= limits.low && value.high <= limits.high)
+                {
+                    range = {Kind::INT, value.low, value.high};
+                }
+            }
+        }
+        else
+        {
+            // still looked at for the diagnostics
+            evaluate(root);
+        }
+        current[id] = range;
+        Range &all = stored[id];
+        all.low = std::min(all.low, range.low);
+        all.high = std::max(all.high, range.high);
+    }
+
+    Range evaluate(const std::shared_ptr<ParseTreeNode> &node)
+    {
+        // raw casts: no reference count to touch for every node
+        if (auto terminal = dynamic_cast<TerminalNode *>(node.get()))
+        {
+            return rangeOf(*terminal);
+        }
+        if (auto unary = dynamic_cast<UnaryNode *>(node.get()))
+        {
+            Range operand = evaluate(unary->getOperand());
+            if (unary->getOperator() == TokenType::NOT_LOGIC)
+            {
+                return {Kind::INT, 0, 1};
+            }
+            if (operand.kind == Kind::INT || operand.kind == Kind::LONG)
+            {
+                return fit({operand.kind, -operand.high, -operand.low});
+            }
+            return full(operand.kind);
+        }
+        auto binary = static_cast<BinaryNode *>(node.get());
+        Range lhs = evaluate(binary->getLhs());
+        Range rhs = evaluate(binary->getRhs());
+        return binaryRange(binary->getOperator(), lhs, rhs);
+    }
+
+    Range rangeOf(TerminalNode &terminal)
+    {
+        const std::string value = terminal.getValue();
+        switch (terminal.getType())
+        {
+        case TokenType::TRUE:
+            return {Kind::INT, 1, 1};
+        case TokenType::FALSE:
+        case TokenType::NULL_KEYWORD:
+            return {Kind::INT, 0, 0};
+        case TokenType::INT_LITERAL:
+        {
+            ConstValue v = intValue(value);
+            if (v.isConstant() && v.integer <= INT32_MAX)
+            {
+                return {Kind::INT, (double)v.integer, (double)v.integer};
+            }
+            context.warning("Integer literal " + value + " at line " + std::to_string(terminal.getLine()) +
+                            " does not fit in an int.");
+            // a hexadecimal or octal one is unsigned, which is not modelled
+            bool isDecimal = value.size() < 2 || value[0] != '0';
+            return v.isConstant() && isDecimal ? Range{Kind::LONG, (double)v.integer, (double)v.integer}
+                                               : full(Kind::OTHER);
+        }
+        case TokenType::FLOAT_LITERAL:
+            return full(Kind::REAL);
+        case TokenType::CHAR_LITERAL:
+        {
+            ConstValue v = charValue(value);
+            return v.isConstant() ? Range{Kind::INT, (double)v.integer, (double)v.integer} : rangeOf(SymbolType::CHAR);
+        }
+        case TokenType::IDENTIFIER:
+        {
+            uint32_t id = names.find(value);
+            return id == StringInterner::NO_ID ? rangeOf(symbols.typeOf(value)) : current[id];
+        }
+        default:
+            return full(Kind::OTHER);
+        }
+    }
+
+    /**
+     * Range of a result that may not fit in its type: an
+     * overflow gives any value, as it does at run time
+     */
+    static Range fit(Range range)
+    {
+        Range limits = full(range.kind);
+        if (range.low < limits.low || range.high > limits.high)
+        {
+            return limits;
+        }
+        return range;
+    }
+
+    static Range binaryRange(TokenType op, const Range &lhs, const Range &rhs)
+    {
+        switch (op)
+        {
+        case TokenType::AND_CONDITIONAL:
+        case TokenType::OR_CONDITIONAL:
+        case TokenType::EQUAL:
+        case TokenType::NOT_EQUAL:
+        case TokenType::LOWER:
+        case TokenType::LOWER_EQUAL:
+        case TokenType::GREATER:
+        case TokenType::GREATER_EQUAL:
+            return {Kind::INT, 0, 1};
+        default:
+            break;
+        }
+
+        Kind kind = std::max(lhs.kind, rhs.kind);
+        if (kind != Kind::INT && kind != Kind::LONG)
+        {
+            return full(kind);
+        }
+        switch (op)
+        {
+        case TokenType::PLUS:
+            return fit({kind, lhs.low + rhs.low, lhs.high + rhs.high});
+        case TokenType::MINUS:
+            return fit({kind, lhs.low - rhs.high, lhs.high - rhs.low});
+        case TokenType::MULTIPLY:
+        {
+            double products[] = {lhs.low * rhs.low, lhs.low * rhs.high, lhs.high * rhs.low, lhs.high * rhs.high};
+            return fit({kind, *std::min_element(products, products + 4), *std::max_element(products, products + 4)});
+        }
+        case TokenType::DIVIDE:
+            return fit(divide(kind, lhs, rhs));
+        case TokenType::MODULO:
+            return modulo(kind, lhs, rhs);
+        default:
+            return bitwise(op, kind, lhs, rhs);
+        }
+    }
+
+    /**
+     * The quotient truncates, which keeps it monotonic in each
+     * operand as long as the divisor keeps its sign: the bounds
+     * are at the corners of the negative and positive divisors
+     */
+    static Range divide(Kind kind, const Range &lhs, const Range &rhs)
+    {
+        Range result = {kind, INFINITY, -INFINITY};
+        auto corners = [&](double low, double high)
+        {
+            if (low > high)
+            {
+                return;
+            }
+            for (double divisor : {low, high})
+            {
+                for (double dividend : {lhs.low, lhs.high})
+                {
+                    double quotient = std::trunc(dividend / divisor);
+                    result.low = std::min(result.low, quotient);
+                    result.high = std::max(result.high, quotient);
+                }
+            }
+        };
+        corners(rhs.low, std::min(rhs.high, -1.0));
+        corners(std::max(rhs.low, 1.0), rhs.high);
+        // a division by zero gives anything
+        return result.isStored() ? result : full(kind);
+    }
+
+    /**
+     * The remainder has the sign of the dividend, and is smaller
+     * than both the dividend and the divisor
+     */
+    static Range modulo(Kind kind, const Range &lhs, const Range &rhs)
+    {
+        double divisor = std::max(std::fabs(rhs.low), std::fabs(rhs.high));
+        if (divisor == 0)
+        {
+            return full(kind);
+        }
+        double low = lhs.low < 0 ? -std::min(-lhs.low, divisor - 1) : 0;
+        double high = lhs.high > 0 ? std::min(lhs.high, divisor - 1) : 0;
+        return {kind, low, high};
+    }
+
+    /**
+     * '&', '|' and '^' never set a bit above the highest one of
+     * their operands, and '&' of a non-negative value is at most
+     * that value
+     */
+    static Range bitwise(TokenType op, Kind kind, const Range &lhs, const Range &rhs)
+    {
+        if (op == TokenType::AND_LOGIC && (lhs.low >= 0 || rhs.low >= 0))
+        {
+            double high = lhs.low >= 0 && rhs.low >= 0 ? std::min(lhs.high, rhs.high)
+                          : lhs.low >= 0               ? lhs.high
+                                                       : rhs.high;
+            return {kind, 0, high};
+        }
+        // smallest power of two above the magnitude of every operand
+        double limit = 1;
+        for (double bound : {lhs.low, lhs.high, rhs.low, rhs.high})
+        {
+            double magnitude = bound < 0 ? -bound - 1 : bound;
+            while (limit <= magnitude)
+            {
+                limit *= 2;
+            }
+        }
+        if (lhs.low >= 0 && rhs.low >= 0)
+        {
+            return {kind, 0, limit - 1};
+        }
+        return {kind, -limit, limit - 1};
+    }
+};
+
+#endif // G_RANGE_ANALYSIS_HPP
@@ -0,0 +1,216 @@
+/**
+ * @file    G-Programming-Language/Compiler/symbol_table_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * Throughput and memory of SymbolTable against the table it
+ * replaced, a std::unordered_map from the name to the symbol.
+ *
+ * Both tables get the same symbols (1M by default, the first
+ * argument changes it): every one is declared, looked up three
+ * times in a scattered order and assigned. The memory is what the
+ * table holds once every symbol is declared, as counted by the
+ * operator new below. The scopes of SymbolTable, which the map
+ * does not have, are measured apart.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "./parser_new.hpp"
+
+using namespace std::chrono;
+
+/**
+ * Bytes held by the heap
+ */
+static long long heapBytes = 0;
+
+void *operator new(size_t size)
+{
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    heapBytes += malloc_usable_size(p);
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    heapBytes -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+/**
+ * The table before the scoped one: node based, a name is hashed
+ * twice when it is declared or assigned
+ */
+class MapSymbolTable
+{
+public:
+    void addSymbol(SymbolType type, const std::string name, int line, ConstValue value = ConstValue())
+    {
+        auto it = symbols.find(name);
+        if (it == symbols.end())
+        {
+            symbols[name] = {type, name, value, line};
+        }
+    }
+
+    int lookupLine(const std::string &name) const
+    {
+        return symbols.find(name)->second.line;
+    }
+
+    void setValue(const std::string &name, ConstValue value)
+    {
+        auto it = symbols.find(name);
+        if (it != symbols.end())
+        {
+            symbols[name].value = value;
+        }
+    }
+
+private:
+    struct MapSymbol
+    {
+        SymbolType type;
+        std::string name;
+        ConstValue value;
+        int line;
+    };
+
+    std::unordered_map<std::string, MapSymbol> symbols;
+};
+
+/**
+ * Line of a symbol, the same way for both tables
+ */
+int lineOf(const MapSymbolTable &table, const std::string &name)
+{
+    return table.lookupLine(name);
+}
+
+int lineOf(const SymbolTable &table, const std::string &name)
+{
+    return table.lookupSymbol(name).line;
+}
+
+void assign(MapSymbolTable &table, const std::string &name, ConstValue value)
+{
+    table.setValue(name, value);
+}
+
+void assign(SymbolTable &table, const std::string &name, ConstValue value)
+{
+    table.setValue(name, value, 0);
+}
+
+/**
+ * Measures a table and prints a row
+ *
+ * @param label of the row
+ * @param table empty, built on the heap so that its memory is counted
+ * @param names of the symbols
+ */
+template <typename Table>
+void measure(const char *label, Table *table, const std::vector<std::string> &names)
+{
+    double n = names.size();
+    long long before = heapBytes;
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        table->addSymbol(SymbolType::INT, names[i], (int)i, ConstValue::ofInt(0));
+    }
+    double insertNs = duration<double, std::nano>(steady_clock::now() - start).count() / n;
+    long long bytes = heapBytes - before;
+
+    // a prime stride, so that consecutive lookups are far apart
+    volatile long long sum = 0;
+    start = steady_clock::now();
+    for (int round = 0; round < 3; ++round)
+    {
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            sum = sum + lineOf(*table, names[(i * 7919) % names.size()]);
+        }
+    }
+    double lookupNs = duration<double, std::nano>(steady_clock::now() - start).count() / (3 * n);
+
+    start = steady_clock::now();
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        assign(*table, names[i], ConstValue::ofInt(1));
+    }
+    double assignNs = duration<double, std::nano>(steady_clock::now() - start).count() / n;
+    delete table;
+
+    std::printf("%-14s %10.1f %10.1f %10.1f %10.1f %8.1f\n", label, insertNs, lookupNs, assignNs, bytes / 1e6,
+                (double)bytes / n);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? std::max(1, atoi(argv[1])) : 1000000;
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        names.push_back("variable_" + std::to_string(i));
+    }
+
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, quiet);
+    std::printf("%zu symbols\n", count);
+    std::printf("%-14s %10s %10s %10s %10s %8s\n", "table", "insert ns", "lookup ns", "assign ns", "MB", "B/sym");
+    // twice each, the first runs also warm up the allocator
+    for (int run = 0; run < 2; ++run)
+    {
+        measure("unordered_map", new MapSymbolTable(), names);
+        measure("SymbolTable", new SymbolTable(context), names);
+    }
+
+    // a block of 100 declarations that shadow globals
+    SymbolTable table(context);
+    for (size_t i = 0; i < 1000 && i < count; ++i)
+    {
+        table.addSymbol(SymbolType::INT, names[i], (int)i);
+    }
+    const int scopes = 10000;
+    auto start = steady_clock::now();
+    for (int s = 0; s < scopes; ++s)
+    {
+        table.pushScope();
+        for (size_t i = 0; i < 100 && i * 10 < count; ++i)
+        {
+            table.addSymbol(SymbolType::INT, names[i * 10], -1);
+        }
+        table.popScope();
+    }
+    double scopeNs = duration<double, std::nano>(steady_clock::now() - start).count() / scopes;
+    std::printf("pushScope, 100 shadowing declarations, popScope: %.0f ns\n", scopeNs);
+    if (table.lookupSymbol(names[0]).line != 0)
+    {
+        std::fprintf(stderr, "[!] popScope did not restore the shadowed symbols.\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,452 @@
+/**
+ * @file    G-Programming-Language/Compiler/symbols.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_SYMBOLS_HPP
+#define G_SYMBOLS_HPP
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./interner.hpp"
+#include "./lexer.hpp"
+
+enum class SymbolType
+{
+    BOOLEAN = (int)TokenType::BOOLEAN_KEYWORD,
+    INT,
+    FLOAT,
+    CHAR,
+    STRING,
+    UNDEFINED = (int)TokenType::UNDEFINED
+};
+
+/**
+ * C++ type of a symbol type
+ *
+ * @param type of the symbol
+ * @return name of the C++ type
+ */
+inline const char *cppType(SymbolType type)
+{
+    switch (type)
+    {
+    case SymbolType::BOOLEAN:
+        return "bool";
+    case SymbolType::INT:
+        return "int";
+    case SymbolType::FLOAT:
+        return "float";
+    case SymbolType::CHAR:
+        return "char";
+    case SymbolType::STRING:
+        return "std::string";
+    default:
+        return "auto";
+    }
+}
+
+/**
+ * Abstract value of a symbol, an element of the constant
+ * propagation lattice: UNKNOWN (nothing assigned yet) is
+ * above every constant, NON_CONSTANT is below all of them.
+ * Booleans and chars are INT constants, as in C++.
+ */
+struct ConstValue
+{
+    enum Kind : uint8_t
+    {
+        UNKNOWN,
+        INT,
+        FLOAT,
+        STRING,
+        NON_CONSTANT
+    };
+
+    Kind kind;
+
+    union
+    {
+        int64_t integer;
+        double real;
+        /**
+         * Id of the string in the interner of the table
+         */
+        uint32_t string;
+    };
+
+    ConstValue() : kind(UNKNOWN), integer(0) {}
+
+    static ConstValue ofInt(int64_t value)
+    {
+        ConstValue v;
+        v.kind = INT;
+        v.integer = value;
+        return v;
+    }
+
+    static ConstValue ofFloat(double value)
+    {
+        ConstValue v;
+        v.kind = FLOAT;
+        v.real = value;
+        return v;
+    }
+
+    static ConstValue ofString(uint32_t id)
+    {
+        ConstValue v;
+        v.kind = STRING;
+        v.string = id;
+        return v;
+    }
+
+    static ConstValue nonConstant()
+    {
+        ConstValue v;
+        v.kind = NON_CONSTANT;
+        return v;
+    }
+
+    bool isConstant() const
+    {
+        return kind == INT || kind == FLOAT || kind == STRING;
+    }
+
+    bool operator==(const ConstValue &other) const
+    {
+        if (kind != other.kind)
+        {
+            return false;
+        }
+        switch (kind)
+        {
+        case INT:
+            return integer == other.integer;
+        case FLOAT:
+            return real == other.real;
+        case STRING:
+            return string == other.string;
+        default:
+            return true;
+        }
+    }
+
+    bool operator!=(const ConstValue &other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * Meet of two values, for a symbol that may hold either
+     *
+     * @param other value
+     * @return the same constant if both agree, NON_CONSTANT otherwise
+     */
+    ConstValue meet(const ConstValue &other) const
+    {
+        if (kind == UNKNOWN)
+        {
+            return other;
+        }
+        if (other.kind == UNKNOWN || *this == other)
+        {
+            return *this;
+        }
+        return nonConstant();
+    }
+};
+
+/**
+ * Value of an int literal, read as C++ does: a leading
+ * zero makes it octal
+ *
+ * @param text of the literal, '-' in front if negated
+ * @return its value, NON_CONSTANT if it is out of range
+ */
+inline ConstValue intValue(const std::string &text)
+{
+    char *end = nullptr;
+    errno = 0;
+    long long value = std::strtoll(text.c_str(), &end, 0);
+    if (errno == ERANGE || *end != '\0')
+    {
+        return ConstValue::nonConstant();
+    }
+    return ConstValue::ofInt(value);
+}
+
+/**
+ * Value of a char literal, escapes included
+ *
+ * @param text of the literal, without quotes
+ * @return its code, NON_CONSTANT for an unknown escape
+ */
+inline ConstValue charValue(const std::string &text)
+{
+    if (text.size() == 1)
+    {
+        return ConstValue::ofInt(text[0]);
+    }
+    if (text.size() == 2 && text[0] == '\\')
+    {
+        switch (text[1])
+        {
+        case 'n':
+            return ConstValue::ofInt('\n');
+        case 't':
+            return ConstValue::ofInt('\t');
+        case 'r':
+            return ConstValue::ofInt('\r');
+        case '\\':
+        case '\'':
+        case '"':
+            return ConstValue::ofInt(text[1]);
+        }
+    }
+    if (text.size() >= 2 && text.size() <= 4 && text[0] == '\\' &&
+        text.find_first_not_of("01234567", 1) == std::string::npos)
+    {
+        // octal, as constant folding writes the unprintable chars
+        return ConstValue::ofInt((char)std::stoi(text.substr(1), nullptr, 8));
+    }
+    return ConstValue::nonConstant();
+}
+
+/**
+ * Contents of a string literal, its escapes replaced by the chars
+ * they stand for as in charValue; unknown escapes are kept as
+ * written
+ *
+ * @param text of the literal, without quotes
+ * @return the chars of the string
+ */
+inline std::string stringValue(const std::string &text)
+{
+    std::string value;
+    value.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] != '\\' || i + 1 == text.size())
+        {
+            value += text[i];
+            continue;
+        }
+        size_t length = 2;
+        while (length < 4 && i + length < text.size() && text[i + length] >= '0' && text[i + length] <= '7' &&
+               text[i + 1] >= '0' && text[i + 1] <= '7')
+        {
+            ++length;
+        }
+        std::string escape = text.substr(i, length);
+        ConstValue c = charValue(escape);
+        value += c.isConstant() ? std::string(1, (char)c.integer) : escape;
+        i += length - 1;
+    }
+    return value;
+}
+
+/**
+ * Text of a value, for diagnostics and dumps
+ *
+ * @param value   to describe
+ * @param strings interner the string constants come from
+ * @return the text
+ */
+inline std::string describe(const ConstValue &value, const StringInterner &strings)
+{
+    std::stringstream ss;
+    switch (value.kind)
+    {
+    case ConstValue::INT:
+        ss << value.integer;
+        break;
+    case ConstValue::FLOAT:
+        ss << value.real;
+        break;
+    case ConstValue::STRING:
+        ss << "\"" << strings.getString(value.string) << "\"";
+        break;
+    case ConstValue::NON_CONSTANT:
+        ss << "non constant";
+        break;
+    default:
+        ss << "unknown";
+        break;
+    }
+    return ss.str();
+}
+
+/**
+ * Symbol of a frozen table, independent of the interner
+ * of the table it comes from
+ */
+struct FrozenSymbol
+{
+    std::string name;
+    SymbolType type;
+    ConstValue value;
+    int line;
+
+    /**
+     * Bits an int is stored in when its values are proven to
+     * fit in fewer than 32, 0 otherwise
+     */
+    uint8_t bits = 0;
+
+    /**
+     * If the symbol is assigned after its declaration: a symbol
+     * that is not keeps the value it was declared with
+     */
+    bool reassigned = false;
+};
+
+/**
+ * Read only symbol table produced at the end of parsing.
+ * Symbols are sorted by name in one array, so lookups are
+ * a binary search and the table can be shared by pointer
+ * between code generation and later passes.
+ */
+class FrozenSymbolTable
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param symbols visible at the end of the program, in any order
+     * @param strings the string constants of the values refer to
+     */
+    FrozenSymbolTable(std::vector<FrozenSymbol> symbols, StringInterner strings)
+        : symbols(std::move(symbols)), strings(std::move(strings))
+    {
+        std::sort(this->symbols.begin(), this->symbols.end(), [](const FrozenSymbol &a, const FrozenSymbol &b)
+                  { return a.name < b.name; });
+        for (const FrozenSymbol &symbol : this->symbols)
+        {
+            types |= typeBit(symbol.type);
+            narrowed = narrowed || symbol.bits != 0;
+        }
+    }
+
+    /**
+     * Symbol with a name
+     *
+     * @param name of the symbol
+     * @return the symbol, nullptr if there is none
+     */
+    const FrozenSymbol *find(const std::string &name) const
+    {
+        auto it = std::lower_bound(symbols.begin(), symbols.end(), name, [](const FrozenSymbol &symbol, const std::string &name)
+                                   { return symbol.name < name; });
+        if (it == symbols.end() || it->name != name)
+        {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    /**
+     * Type of a symbol
+     *
+     * @param name of the symbol
+     * @return its type, UNDEFINED if there is no such symbol
+     */
+    SymbolType typeOf(const std::string &name) const
+    {
+        const FrozenSymbol *symbol = find(name);
+        return symbol ? symbol->type : SymbolType::UNDEFINED;
+    }
+
+    /**
+     * C++ type a symbol is declared with
+     *
+     * @param symbol found in this table, or nullptr
+     * @return name of the C++ type
+     */
+    static const char *cppTypeOf(const FrozenSymbol *symbol)
+    {
+        if (!symbol)
+        {
+            return cppType(SymbolType::UNDEFINED);
+        }
+        if (symbol->type == SymbolType::INT && symbol->bits == 8)
+        {
+            return "int8_t";
+        }
+        if (symbol->type == SymbolType::INT && symbol->bits == 16)
+        {
+            return "int16_t";
+        }
+        return cppType(symbol->type);
+    }
+
+    /**
+     * Checks if some int is stored in fewer than 32 bits
+     */
+    bool isNarrowed() const
+    {
+        return narrowed;
+    }
+
+    /**
+     * Checks if some symbol has a type
+     *
+     * @param type of symbol
+     * @return if at least one symbol has that type
+     */
+    bool uses(SymbolType type) const
+    {
+        return (types & typeBit(type)) != 0;
+    }
+
+    /**
+     * Symbols sorted by name
+     */
+    const std::vector<FrozenSymbol> &getSymbols() const
+    {
+        return symbols;
+    }
+
+    size_t size() const
+    {
+        return symbols.size();
+    }
+
+    /**
+     * String constants of the values
+     */
+    const StringInterner &getStrings() const
+    {
+        return strings;
+    }
+
+private:
+    std::vector<FrozenSymbol> symbols;
+
+    StringInterner strings;
+
+    /**
+     * Bit (type - BOOLEAN) is set for every type in use
+     */
+    uint32_t types = 0;
+
+    bool narrowed = false;
+
+    static uint32_t typeBit(SymbolType type)
+    {
+        int bit = (int)type - (int)SymbolType::BOOLEAN;
+        return bit >= 0 && bit < 32 ? (uint32_t)1 << bit : 0;
+    }
+};
+
+#endif // G_SYMBOLS_HPP
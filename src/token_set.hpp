@@ -0,0 +1,122 @@
+/**
+ * @file    G-Programming-Language/Compiler/token_set.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_TOKEN_SET_HPP
+#define G_TOKEN_SET_HPP
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include "./lexer.hpp"
+
+static_assert((int)TokenType::_EOF < 64, "a TokenSet holds at most 64 token types");
+
+/**
+ * Set of token types stored as a bitmask. It is a literal
+ * type, so sets can be built at compile time and testing
+ * a token is a single 'and'.
+ */
+class TokenSet
+{
+public:
+    constexpr TokenSet() : bits(0) {}
+
+    constexpr TokenSet(std::initializer_list<TokenType> types) : bits(0)
+    {
+        for (TokenType type : types)
+        {
+            bits |= bit(type);
+        }
+    }
+
+    /**
+     * Builds a set from its bitmask
+     *
+     * @param bits bit i is set if TokenType i is in the set
+     * @return the set
+     */
+    static constexpr TokenSet fromBits(uint64_t bits)
+    {
+        return TokenSet(bits, 0);
+    }
+
+    constexpr bool contains(TokenType type) const
+    {
+        return (bits & bit(type)) != 0;
+    }
+
+    constexpr bool empty() const
+    {
+        return bits == 0;
+    }
+
+    /**
+     * Number of token types in the set
+     */
+    constexpr int size() const
+    {
+        int count = 0;
+        for (uint64_t b = bits; b != 0; b &= b - 1)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    constexpr uint64_t getBits() const
+    {
+        return bits;
+    }
+
+    constexpr TokenSet operator|(TokenSet other) const
+    {
+        return fromBits(bits | other.bits);
+    }
+
+    constexpr TokenSet operator&(TokenSet other) const
+    {
+        return fromBits(bits & other.bits);
+    }
+
+    constexpr TokenSet &operator|=(TokenSet other)
+    {
+        bits |= other.bits;
+        return *this;
+    }
+
+    constexpr bool operator==(TokenSet other) const
+    {
+        return bits == other.bits;
+    }
+
+    constexpr bool operator!=(TokenSet other) const
+    {
+        return bits != other.bits;
+    }
+
+private:
+    constexpr TokenSet(uint64_t bits, int) : bits(bits) {}
+
+    static constexpr uint64_t bit(TokenType type)
+    {
+        return (uint64_t)1 << (int)type;
+    }
+
+    uint64_t bits;
+};
+
+/**
+ * Tokens closing a statement, where error recovery resumes
+ */
+constexpr TokenSet STATEMENT_END = {TokenType::SEMICOLON, TokenType::_EOF};
+
+static_assert(STATEMENT_END.size() == 2, "STATEMENT_END");
+static_assert(!STATEMENT_END.contains(TokenType::IDENTIFIER), "STATEMENT_END");
+
+#endif // G_TOKEN_SET_HPP
@@ -0,0 +1,136 @@
+/**
+ * @file    G-Programming-Language/Compiler/token_set_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * Cost of the token predicates of the parser: a TokenSet against
+ * the std::vector of token types the parser used to build on every
+ * check.
+ *
+ * Every set the parser uses is checked against every token type,
+ * many times over; the allocations are counted by the operator new
+ * below. The program fails if a TokenSet check allocates anything.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+#include "./grammar.hpp"
+#include "./token_set.hpp"
+
+using namespace std::chrono;
+
+/**
+ * Allocations made so far
+ */
+static size_t allocations = 0;
+
+void *operator new(size_t size)
+{
+    ++allocations;
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Check as the parser made it before TokenSet: the types are
+ * copied into a new vector at every call, as they were from an
+ * initializer list
+ */
+bool vectorContains(std::vector<TokenType> types, TokenType type)
+{
+    for (TokenType t : types)
+    {
+        if (t == type)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Token types of a set, in order
+ */
+std::vector<TokenType> typesOf(TokenSet set)
+{
+    std::vector<TokenType> types;
+    for (int t = 0; t <= (int)TokenType::_EOF; ++t)
+    {
+        if (set.contains((TokenType)t))
+        {
+            types.push_back((TokenType)t);
+        }
+    }
+    return types;
+}
+
+int main(int argc, char *argv[])
+{
+    const long checks = argc > 1 ? std::max(1L, atol(argv[1])) : 20000000;
+    const int typeCount = (int)TokenType::_EOF + 1;
+    const std::pair<const char *, TokenSet> sets[] = {{"DATA_TYPES", DATA_TYPES},
+                                                      {"EXPRESSION_START", EXPRESSION_START},
+                                                      {"PRIMARY_START", PRIMARY_START},
+                                                      {"BINARY_OPERATORS", BINARY_OPERATORS},
+                                                      {"STATEMENT_END", STATEMENT_END}};
+
+    std::printf("%-17s %5s | %11s %13s | %11s %13s\n", "set", "types", "vector ns", "allocs/check", "TokenSet ns",
+                "allocs/check");
+    bool allocated = false;
+    volatile long sink = 0;
+    for (const auto &set : sets)
+    {
+        std::vector<TokenType> types = typesOf(set.second);
+
+        size_t before = allocations;
+        auto start = steady_clock::now();
+        for (long i = 0; i < checks; ++i)
+        {
+            sink = sink + vectorContains(types, (TokenType)(i % typeCount));
+        }
+        double vectorNs = duration<double, std::nano>(steady_clock::now() - start).count() / checks;
+        double vectorAllocations = (double)(allocations - before) / checks;
+
+        before = allocations;
+        start = steady_clock::now();
+        for (long i = 0; i < checks; ++i)
+        {
+            sink = sink + set.second.contains((TokenType)(i % typeCount));
+        }
+        double setNs = duration<double, std::nano>(steady_clock::now() - start).count() / checks;
+        size_t setAllocations = allocations - before;
+        allocated = allocated || setAllocations != 0;
+
+        std::printf("%-17s %5d | %11.2f %13.2f | %11.2f %13.2f\n", set.first, set.second.size(), vectorNs,
+                    vectorAllocations, setNs, (double)setAllocations / checks);
+    }
+    if (allocated)
+    {
+        std::fprintf(stderr, "[!] A TokenSet check allocated memory.\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,221 @@
+/**
+ * @file    G-Programming-Language/Compiler/unity.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_UNITY_HPP
+#define G_UNITY_HPP
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include "./utils.hpp"
+
+/**
+ * Source files in a directory
+ *
+ * @param directory to list
+ * @return the paths of its .g files, sorted
+ */
+inline std::vector<std::string> sourcesIn(const std::string &directory)
+{
+    std::vector<std::string> paths;
+    DIR *dir = opendir(directory.c_str());
+    if (!dir)
+    {
+        return paths;
+    }
+    std::string prefix = directory.back() == '/' ? directory : directory + "/";
+    while (dirent *entry = readdir(dir))
+    {
+        std::string name = entry->d_name;
+        if (name.size() > 2 && name.compare(name.size() - 2, 2, ".g") == 0)
+        {
+            paths.push_back(prefix + name);
+        }
+    }
+    closedir(dir);
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+/**
+ * Several programs generated into a few translation units, so that
+ * the compiler of the output starts and parses the headers once
+ * per unit instead of once per program. Every program keeps its
+ * main inside a namespace named after its file; the first unit
+ * also has the main of the executable, which runs the program
+ * named by its first argument.
+ */
+class UnityBuild
+{
+public:
+    /**
+     * Adds a program
+     *
+     * @param file     name of its source file, without path and extension
+     * @param includes the program needs
+     * @param body     main function of the program
+     */
+    void add(const std::string &file, const std::string &includes, const std::string &body)
+    {
+        std::string name = "g_";
+        for (char c : file)
+        {
+            name += isIdentifierChar(c) ? c : '_';
+        }
+        // files whose names differ only by the chars replaced
+        std::string unique = name;
+        for (size_t n = 1; std::any_of(programs.begin(), programs.end(), [&](const Program &program)
+                                       { return program.name == unique; });
+             ++n)
+        {
+            unique = name + "_" + std::to_string(n);
+        }
+        programs.push_back({file, unique, includes, body});
+    }
+
+    size_t size() const
+    {
+        return programs.size();
+    }
+
+    /**
+     * Writes the units
+     *
+     * @param base   path of the units, unit k is <base>_<k>.cpp
+     * @param shards number of units, at most one per program
+     * @return the paths of the units written
+     */
+    std::vector<std::string> write(const std::string &base, size_t shards) const
+    {
+        shards = std::max<size_t>(1, std::min(shards, programs.size()));
+        std::vector<std::vector<size_t>> units = assign(shards);
+        std::vector<std::string> paths;
+        for (size_t k = 0; k < shards; ++k)
+        {
+            std::vector<std::string> includes;
+            if (k == 0)
+            {
+                includes = {"#include<cstdio>", "#include<cstring>"};
+            }
+            for (size_t p : units[k])
+            {
+                std::stringstream lines(programs[p].includes);
+                std::string line;
+                while (std::getline(lines, line))
+                {
+                    if (std::find(includes.begin(), includes.end(), line) == includes.end())
+                    {
+                        includes.push_back(line);
+                    }
+                }
+            }
+            std::string code;
+            for (const std::string &line : includes)
+            {
+                code += line + "\n";
+            }
+            for (size_t p : units[k])
+            {
+                code += "namespace " + programs[p].name + "\n{\n" + programs[p].body + "\n}\n";
+            }
+            if (k == 0)
+            {
+                code += dispatcher();
+            }
+            paths.push_back(base + "_" + std::to_string(k) + ".cpp");
+            std::ofstream(paths.back()) << code;
+        }
+        return paths;
+    }
+
+private:
+    struct Program
+    {
+        std::string file;
+        /**
+         * Namespace of the program
+         */
+        std::string name;
+        std::string includes;
+        std::string body;
+    };
+
+    std::vector<Program> programs;
+
+    /**
+     * Splits the programs in units of about the same size: the
+     * largest goes to the smallest unit first. Every unit keeps
+     * its programs in the order they were added.
+     *
+     * @param shards number of units
+     * @return the programs of every unit
+     */
+    std::vector<std::vector<size_t>> assign(size_t shards) const
+    {
+        std::vector<size_t> order(programs.size());
+        for (size_t p = 0; p < order.size(); ++p)
+        {
+            order[p] = p;
+        }
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+                         { return programs[a].body.size() > programs[b].body.size(); });
+        std::vector<std::vector<size_t>> units(shards);
+        std::vector<size_t> sizes(shards, 0);
+        for (size_t p : order)
+        {
+            size_t k = std::min_element(sizes.begin(), sizes.end()) - sizes.begin();
+            units[k].push_back(p);
+            sizes[k] += programs[p].body.size();
+        }
+        for (auto &unit : units)
+        {
+            std::sort(unit.begin(), unit.end());
+        }
+        return units;
+    }
+
+    /**
+     * Main of the executable: runs the program named by its first
+     * argument, with the arguments after it
+     */
+    std::string dispatcher() const
+    {
+        std::string code;
+        for (const Program &program : programs)
+        {
+            code += "namespace " + program.name + "\n{\nint main(int argc, char* argv[]);\n}\n";
+        }
+        code += "int main(int argc, char* argv[])\n{\n";
+        code += "\tstatic const struct { const char *name; int (*main)(int, char*[]); } programs[] = {\n";
+        for (const Program &program : programs)
+        {
+            std::string name;
+            for (char c : program.file)
+            {
+                name += c == '"' || c == '\\' ? std::string("\\") + c : std::string(1, c);
+            }
+            code += "\t\t{\"" + name + "\", " + program.name + "::main},\n";
+        }
+        code += "\t};\n";
+        code += "\tfor (const auto &program : programs)\n\t{\n";
+        code += "\t\tif (argc > 1 && std::strcmp(argv[1], program.name) == 0)\n\t\t{\n";
+        code += "\t\t\treturn program.main(argc - 1, argv + 1);\n\t\t}\n\t}\n";
+        code += "\tstd::fprintf(stderr, \"Usage: %s <program> [arguments], the programs are:\\n\", argv[0]);\n";
+        code += "\tfor (const auto &program : programs)\n\t{\n";
+        code += "\t\tstd::fprintf(stderr, \"  %s\\n\", program.name);\n\t}\n";
+        code += "\treturn 1;\n}\n";
+        return code;
+    }
+};
+
+#endif // G_UNITY_HPP
@@ -0,0 +1,167 @@
+/**
+ * @file    G-Programming-Language/Compiler/unity_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * End-to-end time of building many programs: a .cpp and an
+ * executable per program, against a unity build in a few
+ * translation units.
+ *
+ * 32 generated programs of 100 statements (the first argument
+ * changes the number of programs) are compiled and built, as with
+ * gcompile <dir> -O0 --build [--unity=K], every time with an empty
+ * object cache: one executable per program, then a unity build in
+ * 1, 2, 4 and 8 shards, both with the C++ compiled at -O2 and at
+ * -O0. The last row rebuilds the 4 shards with the cache filled,
+ * so nothing is compiled. The host compiler is c++, or the CXX
+ * environment variable; its jobs are the cores of the machine.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "./compiler.hpp"
+
+using namespace std::chrono;
+
+/**
+ * Deterministic generator, so every run builds the same programs
+ */
+struct Random
+{
+    uint64_t state;
+
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (uint32_t)(state >> 33) % bound;
+    }
+};
+
+/**
+ * A program of ints, floats and strings
+ *
+ * @param random     generator
+ * @param statements number of statements
+ * @return the source
+ */
+std::string generate(Random &random, int statements)
+{
+    std::stringstream ss;
+    ss << "int i0 = " << random.next(100) << ";\nfloat f1 = 1.5;\nstring s2 = \"g\";\n";
+    for (int s = 3; s < statements; ++s)
+    {
+        int earlier = 3 * random.next(s / 3);
+        switch (s % 3)
+        {
+        case 0:
+            ss << "int i" << s << " = i" << earlier << " * " << 1 + random.next(9) << " + " << random.next(100)
+               << ";\n";
+            break;
+        case 1:
+            ss << "float f" << s << " = f" << earlier + 1 << " * 0.5 + i" << earlier << ";\n";
+            break;
+        default:
+            ss << "string s" << s << " = \"value " << s << "\";\n";
+            break;
+        }
+    }
+    return ss.str();
+}
+
+/**
+ * Compiles and builds the programs
+ *
+ * @param paths  of the programs
+ * @param flags  of the host compiler
+ * @param shards of the unity build, 0 for an executable per program
+ * @param cache  directory of the objects
+ * @return the time in milliseconds, negative if the build failed
+ */
+double buildAll(const std::vector<std::string> &paths, const std::string &flags, size_t shards,
+                const std::string &cache)
+{
+    std::ostream quiet(nullptr);
+    CompilationContext context(quiet, quiet);
+    CompileOptions options;
+    options.level = 0;
+    options.build = true;
+    options.shards = shards;
+    options.jobs = std::max(1u, std::thread::hardware_concurrency());
+    const char *cxx = std::getenv("CXX");
+    options.downstream.compiler = cxx ? cxx : options.downstream.compiler;
+    options.downstream.flags = "-std=c++14 " + flags;
+    options.downstream.cacheDir = cache;
+    auto start = steady_clock::now();
+    int code = compileFiles(paths, options, context);
+    double ms = duration<double, std::milli>(steady_clock::now() - start).count();
+    return code == SUCCESSFUL_COMPILATION ? ms : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    int programs = argc > 1 ? std::max(1, atoi(argv[1])) : 32;
+    const int statements = 100;
+
+    char directory[] = "/tmp/g_unity_benchmark_XXXXXX";
+    if (!mkdtemp(directory))
+    {
+        std::cerr << "[!] Cannot create a temporary directory.\n";
+        return EXIT_FAILURE;
+    }
+    Random random = {50};
+    std::vector<std::string> paths;
+    for (int p = 0; p < programs; ++p)
+    {
+        paths.push_back(std::string(directory) + "/p" + std::to_string(p) + ".g");
+        std::ofstream(paths.back()) << generate(random, statements);
+    }
+
+    std::printf("%d programs of %d statements, %u jobs\n", programs, statements,
+                std::max(1u, std::thread::hardware_concurrency()));
+    std::printf("%-22s %10s %10s\n", "build", "-O2 ms", "-O0 ms");
+    const size_t shards[] = {0, 1, 2, 4, 8};
+    int caches = 0;
+    bool failed = false;
+    for (size_t k : shards)
+    {
+        double ms[2];
+        for (int f = 0; f < 2; ++f)
+        {
+            std::string cache = std::string(directory) + "/cache" + std::to_string(caches++);
+            ms[f] = buildAll(paths, f ? "-O0" : "-O2", k, cache);
+            failed = failed || ms[f] < 0;
+        }
+        std::string label = k ? "unity, " + std::to_string(k) + " shards"
+                              : "separate, " + std::to_string(programs) + " units";
+        std::printf("%-22s %10.0f %10.0f\n", label.c_str(), ms[0], ms[1]);
+    }
+    // the caches of the 4 shards are the 7th and the 8th
+    double warm[2];
+    for (int f = 0; f < 2; ++f)
+    {
+        warm[f] = buildAll(paths, f ? "-O0" : "-O2", 4, std::string(directory) + "/cache" + std::to_string(6 + f));
+        failed = failed || warm[f] < 0;
+    }
+    std::printf("%-22s %10.0f %10.0f\n", "warm rebuild, 4 shards", warm[0], warm[1]);
+
+    std::system(("rm -rf " + shellQuote(directory)).c_str());
+    if (failed)
+    {
+        std::cerr << "[!] A build failed.\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -11,28 +11,7 @@
 #define G_UTILS_HPP
 #pragma once
 
-#include <iostream>
-
-/**
- * Prints the given error message
- *
- * @param msg message to print
- */
-void errorMessage(std::string msg)
-{
-    std::cout << "[!] " << msg << std::endl;
-}
-
-/**
- * Prints a warning message, which doesn't
- * oblige to stop the compilation process
- * 
- * @param msg message to print
- */
-void warningMessage(std::string msg)
-{
-    std::cout << "(!) " << msg << std::endl;
-}
+#include <string>
 
 /**
  * Checks if a character is '\n'
@@ -40,7 +19,7 @@ void warningMessage(std::string msg)
  * @param c character
  * @return  if it is '\n'
  */
-bool isNewLine(char c)
+inline bool isNewLine(char c)
 {
     return (c == '\n');
 }
@@ -51,7 +30,7 @@ bool isNewLine(char c)
  * @param c character
  * @return  if it is skippable
  */
-bool isSkippable(char c)
+inline bool isSkippable(char c)
 {
     if (c == ' ')
     {
@@ -87,7 +66,7 @@ bool isSkippable(char c)
  * @param c character
  * @return  if it is an arithmetic operator
  */
-bool isArithmeticOp(char c)
+inline bool isArithmeticOp(char c)
 {
     if (c == '+')
     {
@@ -124,7 +103,7 @@ bool isArithmeticOp(char c)
  * @param c character
  * @return  if it is a cond. or log. operator
  */
-bool isConditionalLogicalOp(char c)
+inline bool isConditionalLogicalOp(char c)
 {
     if (c == '&')
     {
@@ -156,6 +135,11 @@ bool isConditionalLogicalOp(char c)
         return true;
     }
 
+    if (c == '!')
+    {
+        return true;
+    }
+
     return false;
 }
 
@@ -167,7 +151,7 @@ bool isConditionalLogicalOp(char c)
  * @param c character
  * @return  if it is one of those characters
  */
-bool isNumberLiteralEnd(char c)
+inline bool isNumberLiteralEnd(char c)
 {
     // multiple number declaration
     if (c == ',')
@@ -214,6 +198,17 @@ bool isNumberLiteralEnd(char c)
     return false;
 }
 
+/**
+ * Checks if a character can be part of an identifier
+ *
+ * @param c character
+ * @return  if it is a letter, a digit or '_'
+ */
+inline bool isIdentifierChar(char c)
+{
+    return isalnum((unsigned char)c) || c == '_';
+}
+
 /**
  * Look at the (pos + offset)th character of the source code
  *
@@ -222,7 +217,7 @@ bool isNumberLiteralEnd(char c)
  * @param offset offset of the char to look at
  * @return       character found at position: pos + offset
  */
-char lookahead(std::string src, size_t pos, size_t offset = 1)
+inline char lookahead(std::string src, size_t pos, size_t offset = 1)
 {
     return src[pos + offset];
 }
@@ -0,0 +1,509 @@
+/**
+ * @file    G-Programming-Language/Compiler/vm.hpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef G_VM_HPP
+#define G_VM_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "./bytecode.hpp"
+
+/**
+ * Interpreter of Bytecode.
+ *
+ * Before the first run the program is decoded, in one pass over
+ * its words, into one slot per instruction with its operands
+ * unpacked; the later runs of the same machine reuse the slots.
+ * With GCC and Clang the slot also holds the address of the code
+ * of its instruction, so every instruction ends by jumping
+ * straight to the next one (direct threading) and there is no
+ * central loop whose single indirect branch mispredicts on every
+ * change of opcode. Other compilers get a switch over the same
+ * slots.
+ */
+class VirtualMachine
+{
+public:
+    /**
+     * Default constructor
+     *
+     * @param program to run, its sections must outlive the machine
+     */
+    explicit VirtualMachine(const BcImage &program) : program(program) {}
+
+    /**
+     * Runs the program from the start, with every variable zero
+     *
+     * @return false after a runtime error, see getError
+     */
+    bool run()
+    {
+        registers.assign(program.registers, BcValue());
+        for (uint32_t v = 0; v < program.variableCount; ++v)
+        {
+            if (program.variables[v].type == IrType::STRING)
+            {
+                registers[program.variables[v].reg].s = empty();
+            }
+        }
+        heap.clear();
+        error.clear();
+        return execute();
+    }
+
+    const std::string &getError() const
+    {
+        return error;
+    }
+
+    /**
+     * Value of a register after the run
+     */
+    BcValue at(uint32_t reg) const
+    {
+        return registers.at(reg);
+    }
+
+    /**
+     * Prints the final value of every variable that was assigned,
+     * one per line as "name = value"
+     *
+     * @param out stream to print to
+     */
+    void printValues(std::ostream &out) const
+    {
+        for (uint32_t v = 0; v < program.variableCount; ++v)
+        {
+            const BcVariable &variable = program.variables[v];
+            if (!variable.assigned)
+            {
+                continue;
+            }
+            BcValue value = registers.at(variable.reg);
+            out << program.string(variable.name)->chars() << " = ";
+            switch (variable.type)
+            {
+            case IrType::BOOL:
+                out << (value.i ? "true" : "false");
+                break;
+            case IrType::CHAR:
+                out << (char)value.i;
+                break;
+            case IrType::FLOAT:
+                out << value.f;
+                break;
+            case IrType::DOUBLE:
+                out << value.d;
+                break;
+            case IrType::STRING:
+                out.write(value.s->chars(), value.s->size);
+                break;
+            default:
+                out << value.i;
+                break;
+            }
+            out << "\n";
+        }
+    }
+
+private:
+    /**
+     * An instruction ready to be executed
+     */
+    struct Slot
+    {
+        const void *handler;
+        BcOp op;
+        uint32_t a;
+        uint32_t b;
+        uint32_t c;
+    };
+
+    BcImage program;
+
+    std::vector<Slot> slots;
+
+    std::vector<BcValue> registers;
+
+    /**
+     * Records of the strings made while running
+     */
+    std::vector<std::unique_ptr<uint64_t[]>> heap;
+
+    std::string error;
+
+    void decode(const void *const *handlers)
+    {
+        slots.clear();
+        slots.reserve(program.codeSize);
+        for (uint32_t pc = 0; pc < program.codeSize; ++pc)
+        {
+            uint64_t word = program.code[pc];
+            BcOp op = BcWord::opOf(word);
+            Slot slot = {handlers ? handlers[(int)op] : nullptr, op, BcWord::aOf(word), BcWord::bOf(word),
+                         BcWord::cOf(word)};
+            if (op == BcOp::LOADK || op == BcOp::LOADI || op == BcOp::LOADS || op >= BcOp::JMP)
+            {
+                slot.b = (uint32_t)BcWord::bxOf(word);
+            }
+            slots.push_back(slot);
+        }
+    }
+
+    /**
+     * Record of the empty string, the value of the string variables
+     * before they are assigned
+     */
+    static const BcString *empty()
+    {
+        static const uint64_t record[2] = {0, 0};
+        return reinterpret_cast<const BcString *>(record);
+    }
+
+    static int32_t wrap(int64_t value)
+    {
+        return (int32_t)(uint32_t)value;
+    }
+
+    /**
+     * float or double to int, INT_MIN when it does not fit
+     */
+    template <typename Real>
+    static int32_t truncate(Real value)
+    {
+        return value >= (Real)-2147483648.0 && value < (Real)2147483648.0 ? (int32_t)value : INT32_MIN;
+    }
+
+    /**
+     * A new string, nullptr if it would be longer than a record can
+     * say
+     */
+    const BcString *concatenate(const BcString *lhs, const BcString *rhs)
+    {
+        uint64_t size = (uint64_t)lhs->size + rhs->size;
+        if (size > UINT32_MAX)
+        {
+            return nullptr;
+        }
+        size_t words = BcString::words((size_t)size);
+        heap.emplace_back(new uint64_t[words]());
+        BcString *record = reinterpret_cast<BcString *>(heap.back().get());
+        record->size = (uint32_t)size;
+        char *chars = const_cast<char *>(record->chars());
+        std::memcpy(chars, lhs->chars(), lhs->size);
+        std::memcpy(chars + lhs->size, rhs->chars(), rhs->size);
+        return record;
+    }
+
+    /**
+     * Compares two strings as std::string does
+     */
+    static int compare(const BcString *lhs, const BcString *rhs)
+    {
+        int order = std::memcmp(lhs->chars(), rhs->chars(), std::min(lhs->size, rhs->size));
+        if (order != 0)
+        {
+            return order;
+        }
+        return lhs->size < rhs->size ? -1 : lhs->size > rhs->size;
+    }
+
+    bool fail(const std::string &why, const Slot *ip)
+    {
+        error = why + " at " + std::to_string(ip - slots.data());
+        return false;
+    }
+
+    bool execute()
+    {
+#if defined(__GNUC__)
+        // in the order of BcOp
+        static const void *const handlers[] = {
+            &&MOVE, &&LOADK, &&LOADI, &&LOADS, &&ADDI, &&SUBI, &&MULI, &&DIVI, &&MODI, &&ANDI, &&ORI, &&XORI, &&NEGI,
+            &&NOTB, &&EQI, &&NEI, &&LTI, &&LEI, &&GTI, &&GEI, &&ADDF, &&SUBF, &&MULF, &&DIVF, &&NEGF, &&EQF,
+            &&NEF, &&LTF, &&LEF, &&GTF, &&GEF, &&ADDD, &&SUBD, &&MULD, &&DIVD, &&NEGD, &&EQD, &&NED, &&LTD,
+            &&LED, &&GTD, &&GED, &&ADDS, &&EQS, &&NES, &&LTS, &&LES, &&GTS, &&GES, &&I2C, &&I2B, &&I2F, &&I2D,
+            &&F2I, &&F2B, &&F2D, &&D2I, &&D2B, &&D2F, &&JMP, &&JMPF, &&JMPT, &&RET};
+        static_assert(sizeof(handlers) / sizeof(*handlers) == (size_t)BcOp::RET + 1, "a handler per opcode");
+        if (slots.size() != program.codeSize)
+        {
+            decode(handlers);
+        }
+#define G_VM_CASE(name) name:
+#define G_VM_NEXT()        \
+    {                      \
+        ++ip;              \
+        goto *ip->handler; \
+    }
+#define G_VM_JUMP(to)             \
+    {                             \
+        ip = slots.data() + (to); \
+        goto *ip->handler;        \
+    }
+#else
+        if (slots.size() != program.codeSize)
+        {
+            decode(nullptr);
+        }
+// a block, not do while (0), or 'continue' would not reach the loop
+#define G_VM_CASE(name) case BcOp::name:
+#define G_VM_NEXT() \
+    {               \
+        ++ip;       \
+        continue;   \
+    }
+#define G_VM_JUMP(to)             \
+    {                             \
+        ip = slots.data() + (to); \
+        continue;                 \
+    }
+#endif
+
+        BcValue *r = registers.data();
+        const BcValue *k = program.constants;
+        const Slot *ip = slots.data();
+#if defined(__GNUC__)
+        goto *ip->handler;
+#else
+        for (;;)
+        {
+            switch (ip->op)
+            {
+#endif
+        G_VM_CASE(MOVE)
+        r[ip->a] = r[ip->b];
+        G_VM_NEXT();
+        G_VM_CASE(LOADK)
+        r[ip->a] = k[ip->b];
+        G_VM_NEXT();
+        G_VM_CASE(LOADI)
+        r[ip->a].i = (int32_t)ip->b;
+        G_VM_NEXT();
+        G_VM_CASE(LOADS)
+        r[ip->a].s = program.string(ip->b);
+        G_VM_NEXT();
+        G_VM_CASE(ADDI)
+        r[ip->a].i = wrap((int64_t)r[ip->b].i + r[ip->c].i);
+        G_VM_NEXT();
+        G_VM_CASE(SUBI)
+        r[ip->a].i = wrap((int64_t)r[ip->b].i - r[ip->c].i);
+        G_VM_NEXT();
+        G_VM_CASE(MULI)
+        r[ip->a].i = wrap((int64_t)r[ip->b].i * r[ip->c].i);
+        G_VM_NEXT();
+        G_VM_CASE(DIVI)
+        if (r[ip->c].i == 0)
+        {
+            return fail("division by zero", ip);
+        }
+        // INT_MIN / -1 traps in the machine code of the other backends
+        if (r[ip->c].i == -1 && r[ip->b].i == INT32_MIN)
+        {
+            return fail("division overflow", ip);
+        }
+        r[ip->a].i = r[ip->b].i / r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(MODI)
+        if (r[ip->c].i == 0)
+        {
+            return fail("division by zero", ip);
+        }
+        if (r[ip->c].i == -1 && r[ip->b].i == INT32_MIN)
+        {
+            return fail("division overflow", ip);
+        }
+        r[ip->a].i = r[ip->b].i % r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(ANDI)
+        r[ip->a].i = r[ip->b].i & r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(ORI)
+        r[ip->a].i = r[ip->b].i | r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(XORI)
+        r[ip->a].i = r[ip->b].i ^ r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(NEGI)
+        r[ip->a].i = wrap(-(int64_t)r[ip->b].i);
+        G_VM_NEXT();
+        G_VM_CASE(NOTB)
+        r[ip->a].i = !r[ip->b].i;
+        G_VM_NEXT();
+        G_VM_CASE(EQI)
+        r[ip->a].i = r[ip->b].i == r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(NEI)
+        r[ip->a].i = r[ip->b].i != r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(LTI)
+        r[ip->a].i = r[ip->b].i < r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(LEI)
+        r[ip->a].i = r[ip->b].i <= r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(GTI)
+        r[ip->a].i = r[ip->b].i > r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(GEI)
+        r[ip->a].i = r[ip->b].i >= r[ip->c].i;
+        G_VM_NEXT();
+        G_VM_CASE(ADDF)
+        r[ip->a].f = r[ip->b].f + r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(SUBF)
+        r[ip->a].f = r[ip->b].f - r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(MULF)
+        r[ip->a].f = r[ip->b].f * r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(DIVF)
+        r[ip->a].f = r[ip->b].f / r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(NEGF)
+        r[ip->a].f = -r[ip->b].f;
+        G_VM_NEXT();
+        G_VM_CASE(EQF)
+        r[ip->a].i = r[ip->b].f == r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(NEF)
+        r[ip->a].i = r[ip->b].f != r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(LTF)
+        r[ip->a].i = r[ip->b].f < r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(LEF)
+        r[ip->a].i = r[ip->b].f <= r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(GTF)
+        r[ip->a].i = r[ip->b].f > r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(GEF)
+        r[ip->a].i = r[ip->b].f >= r[ip->c].f;
+        G_VM_NEXT();
+        G_VM_CASE(ADDD)
+        r[ip->a].d = r[ip->b].d + r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(SUBD)
+        r[ip->a].d = r[ip->b].d - r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(MULD)
+        r[ip->a].d = r[ip->b].d * r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(DIVD)
+        r[ip->a].d = r[ip->b].d / r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(NEGD)
+        r[ip->a].d = -r[ip->b].d;
+        G_VM_NEXT();
+        G_VM_CASE(EQD)
+        r[ip->a].i = r[ip->b].d == r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(NED)
+        r[ip->a].i = r[ip->b].d != r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(LTD)
+        r[ip->a].i = r[ip->b].d < r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(LED)
+        r[ip->a].i = r[ip->b].d <= r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(GTD)
+        r[ip->a].i = r[ip->b].d > r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(GED)
+        r[ip->a].i = r[ip->b].d >= r[ip->c].d;
+        G_VM_NEXT();
+        G_VM_CASE(ADDS)
+        r[ip->a].s = concatenate(r[ip->b].s, r[ip->c].s);
+        if (!r[ip->a].s)
+        {
+            return fail("string too long", ip);
+        }
+        G_VM_NEXT();
+        G_VM_CASE(EQS)
+        r[ip->a].i = compare(r[ip->b].s, r[ip->c].s) == 0;
+        G_VM_NEXT();
+        G_VM_CASE(NES)
+        r[ip->a].i = compare(r[ip->b].s, r[ip->c].s) != 0;
+        G_VM_NEXT();
+        G_VM_CASE(LTS)
+        r[ip->a].i = compare(r[ip->b].s, r[ip->c].s) < 0;
+        G_VM_NEXT();
+        G_VM_CASE(LES)
+        r[ip->a].i = compare(r[ip->b].s, r[ip->c].s) <= 0;
+        G_VM_NEXT();
+        G_VM_CASE(GTS)
+        r[ip->a].i = compare(r[ip->b].s, r[ip->c].s) > 0;
+        G_VM_NEXT();
+        G_VM_CASE(GES)
+        r[ip->a].i = compare(r[ip->b].s, r[ip->c].s) >= 0;
+        G_VM_NEXT();
+        G_VM_CASE(I2C)
+        r[ip->a].i = (char)r[ip->b].i;
+        G_VM_NEXT();
+        G_VM_CASE(I2B)
+        r[ip->a].i = r[ip->b].i != 0;
+        G_VM_NEXT();
+        G_VM_CASE(I2F)
+        r[ip->a].f = (float)r[ip->b].i;
+        G_VM_NEXT();
+        G_VM_CASE(I2D)
+        r[ip->a].d = r[ip->b].i;
+        G_VM_NEXT();
+        G_VM_CASE(F2I)
+        r[ip->a].i = truncate(r[ip->b].f);
+        G_VM_NEXT();
+        G_VM_CASE(F2B)
+        r[ip->a].i = r[ip->b].f != 0;
+        G_VM_NEXT();
+        G_VM_CASE(F2D)
+        r[ip->a].d = r[ip->b].f;
+        G_VM_NEXT();
+        G_VM_CASE(D2I)
+        r[ip->a].i = truncate(r[ip->b].d);
+        G_VM_NEXT();
+        G_VM_CASE(D2B)
+        r[ip->a].i = r[ip->b].d != 0;
+        G_VM_NEXT();
+        G_VM_CASE(D2F)
+        r[ip->a].f = (float)r[ip->b].d;
+        G_VM_NEXT();
+        G_VM_CASE(JMP)
+        G_VM_JUMP(ip->b);
+        G_VM_CASE(JMPF)
+        if (!r[ip->a].i)
+        {
+            G_VM_JUMP(ip->b);
+        }
+        G_VM_NEXT();
+        G_VM_CASE(JMPT)
+        if (r[ip->a].i)
+        {
+            G_VM_JUMP(ip->b);
+        }
+        G_VM_NEXT();
+        G_VM_CASE(RET)
+        return true;
+#if !defined(__GNUC__)
+            }
+        }
+#endif
+#undef G_VM_CASE
+#undef G_VM_NEXT
+#undef G_VM_JUMP
+    }
+};
+
+#endif // G_VM_HPP
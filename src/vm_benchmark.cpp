@@ -0,0 +1,232 @@
+/**
+ * @file    G-Programming-Language/Compiler/vm_benchmark.cpp
+ * @author  Vincenzo Cardea (vincenzo.cardea.05@gmail.com)
+ * @version 0.1
+ * @date    2026-19-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+/*
+ * Throughput of the virtual machine against the C++ the compiler
+ * generates for the same programs.
+ *
+ * Every workload is a generated program; the machine runs it in a
+ * loop for a fixed time. The C++ of the same program is built by
+ * g++ at -O0 and at -O2 with a main that runs it in the same way,
+ * so both sides measure execution only; the time g++ takes is
+ * reported apart, since the machine has nothing comparable.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./bytecode.hpp"
+#include "./compiler.hpp"
+#include "./vm.hpp"
+
+using namespace std::chrono;
+
+/**
+ * How long every measure runs
+ */
+static const double MEASURE_MS = 300;
+
+/**
+ * Deterministic generator, so every run measures the same programs
+ */
+struct Random
+{
+    uint64_t state;
+
+    uint32_t next(uint32_t bound)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (uint32_t)(state >> 33) % bound;
+    }
+};
+
+/**
+ * Program of a workload. Every value stays small, so the C++ has
+ * no overflow and no division by zero.
+ *
+ * @param workload   int, float, mixed or logic
+ * @param statements number of declarations
+ * @return the source
+ */
+std::string generate(const std::string &workload, int statements)
+{
+    Random random = {(uint64_t)workload.size() * 7919 + (uint64_t)statements};
+    std::stringstream ss;
+    ss << "int i0 = 7;\nint i1 = 11;\nfloat f0 = 1.5;\nfloat f1 = 2.25;\nboolean b0 = true;\n";
+    static const char *const intOps[] = {"+", "-", "*", "&", "|", "^"};
+    static const char *const floatOps[] = {"+", "-", "*"};
+    static const char *const comparisons[] = {"<", "<=", ">", ">=", "==", "!="};
+    int ints = 2, floats = 2, bools = 1;
+    for (int s = 0; s < statements; ++s)
+    {
+        std::string kind = workload;
+        if (workload == "mixed")
+        {
+            static const char *const kinds[] = {"int", "float", "logic"};
+            kind = kinds[random.next(3)];
+        }
+        auto i = [&]()
+        { return "i" + std::to_string(ints - 1 - (int)random.next(std::min(ints, 8))); };
+        auto f = [&]()
+        { return "f" + std::to_string(floats - 1 - (int)random.next(std::min(floats, 8))); };
+        auto b = [&]()
+        { return "b" + std::to_string(bools - 1 - (int)random.next(std::min(bools, 8))); };
+        // operands first: the new variable is not visible yet
+        std::stringstream expression;
+        if (kind == "int")
+        {
+            expression << "(" << i() << " " << intOps[random.next(6)] << " " << i() << " "
+                       << intOps[random.next(6)] << " " << 1 + random.next(50) << ") % 1009";
+            ss << "int i" << ints++ << " = " << expression.str() << ";\n";
+        }
+        else if (kind == "float")
+        {
+            expression << "(" << f() << " " << floatOps[random.next(3)] << " " << f() << ") / "
+                       << 2 + random.next(7) << ".5 + " << i();
+            ss << "float f" << floats++ << " = " << expression.str() << ";\n";
+        }
+        else
+        {
+            expression << i() << " " << comparisons[random.next(6)] << " " << i()
+                       << (random.next(2) ? " && " : " || ") << "(" << b() << " || " << f() << " "
+                       << comparisons[random.next(6)] << " " << f() << ")";
+            ss << "boolean b" << bools++ << " = " << expression.str() << ";\n";
+        }
+    }
+    return ss.str();
+}
+
+/**
+ * C++ of a program with a main that runs it for MEASURE_MS and
+ * prints the nanoseconds of one run
+ */
+std::string harness(const std::string &code)
+{
+    std::string program = code;
+    const std::string entry = "int main(";
+    program.replace(program.find(entry), entry.size(), "int g_program(");
+    std::stringstream ss;
+    ss << program << "\n#include <chrono>\n"
+       << "int main(int argc, char *argv[])\n{\n"
+       << "\tauto start = std::chrono::steady_clock::now();\n"
+       << "\tlong runs = 0;\n\tdouble ns = 0;\n"
+       << "\tdo\n\t{\n\t\tfor (int i = 0; i < 64; ++i)\n\t\t{\n\t\t\tg_program(argc, argv);\n\t\t}\n"
+       << "\t\truns += 64;\n"
+       << "\t\tns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();\n"
+       << "\t} while (ns < " << MEASURE_MS << "e6);\n"
+       << "\tstd::cout << ns / runs << std::endl;\n\treturn 0;\n}\n";
+    return ss.str();
+}
+
+/**
+ * Builds and runs the C++ of a program
+ *
+ * @param source of the harness
+ * @param level  optimisation flag of g++
+ * @param build  where the milliseconds of g++ are stored
+ * @return nanoseconds of one run, negative if it could not be built
+ */
+double runCpp(const std::string &source, const std::string &level, double &build)
+{
+    const std::string base = "/tmp/g_vm_benchmark" + level;
+    std::ofstream(base + ".cpp") << source;
+    auto start = steady_clock::now();
+    int status = std::system(("g++ -std=c++14 -w " + level + " -o " + base + " " + base + ".cpp").c_str());
+    build = duration<double, std::milli>(steady_clock::now() - start).count();
+    if (status != 0)
+    {
+        return -1;
+    }
+    FILE *pipe = popen(base.c_str(), "r");
+    double ns = -1;
+    if (pipe)
+    {
+        if (std::fscanf(pipe, "%lf", &ns) != 1)
+        {
+            ns = -1;
+        }
+        pclose(pipe);
+    }
+    return ns;
+}
+
+int main(int argc, char *argv[])
+{
+    int statements = 2000;
+    bool cpp = true;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--no-cpp")
+        {
+            cpp = false;
+        }
+        else
+        {
+            statements = std::max(1, atoi(arg.c_str()));
+        }
+    }
+
+    std::printf("%-7s %7s %7s %12s %9s | %11s %12s | %11s %12s\n", "program", "stmts", "instrs", "vm ns/run",
+                "ns/instr", "-O0 g++ ms", "-O0 ns/run", "-O2 g++ ms", "-O2 ns/run");
+    for (const std::string workload : {"int", "float", "logic", "mixed"})
+    {
+        std::string source = generate(workload, statements);
+        std::ostream quiet(nullptr);
+        CompilationContext context(quiet);
+        Lexer lexer(context, source);
+        std::vector<Token> tokens = lexer.lex();
+        Parser parser(context, tokens);
+        std::shared_ptr<ParseTreeNode> tree = parser.parse(1);
+        if (!parser.isValid())
+        {
+            std::cerr << "[!] " << workload << " is not valid.\n";
+            return INVALID_SYNTAX;
+        }
+        Bytecode bytecode;
+        BytecodeCompiler compiler(*parser.getSymbolTable());
+        if (!compiler.compile(tree, bytecode))
+        {
+            std::cerr << "[!] " << workload << ": " << compiler.getError() << ".\n";
+            return CODE_NOT_GENERATED;
+        }
+
+        VirtualMachine vm(bytecode.image());
+        long runs = 0;
+        double ns = 0;
+        auto start = steady_clock::now();
+        do
+        {
+            for (int i = 0; i < 64; ++i)
+            {
+                vm.run();
+            }
+            runs += 64;
+            ns = duration<double, std::nano>(steady_clock::now() - start).count();
+        } while (ns < MEASURE_MS * 1e6);
+        double vmRun = ns / runs;
+
+        double build0 = 0, build2 = 0, run0 = -1, run2 = -1;
+        if (cpp)
+        {
+            std::string code = harness(CodeGenerator(parser.getSymbolTable()).generateCode(tree));
+            run0 = runCpp(code, "-O0", build0);
+            run2 = runCpp(code, "-O2", build2);
+        }
+        std::printf("%-7s %7d %7zu %12.0f %9.2f | %11.0f %12.0f | %11.0f %12.1f\n", workload.c_str(), statements,
+                    bytecode.code.size(), vmRun, vmRun / bytecode.code.size(), build0, run0, build2, run2);
+    }
+    return SUCCESSFUL_COMPILATION;
+}